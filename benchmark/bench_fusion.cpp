@@ -0,0 +1,108 @@
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+
+// This file was generated in part with generative AI
+
+// Three ideal-gas equation-of-state kernels over the same 3D range,
+// reading density and energy and writing pressure, temperature and
+// bulk modulus, run as three portableFor launches and as one
+// portableForFused. Separately they move 8 fields' worth of data, fused
+// only 5 (each input is read once), so when memory bound the fused
+// version should take about 5/8 of the time.
+//
+// usage: bench_fusion [n = 192] [repetitions = 20]
+
+#include <ports-of-call/portability.hpp>
+#include <ports-of-call/portable_arrays.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+template <typename Run>
+double BestSeconds(int repetitions, const Run &run) {
+  double best = std::numeric_limits<double>::max();
+  for (int r = 0; r < repetitions; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    PORTABLE_FENCE();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::ScopeGuard guard(argc, argv);
+#endif
+  const int n = argc > 1 ? std::atoi(argv[1]) : 192;
+  const int repetitions = argc > 2 ? std::atoi(argv[2]) : 20;
+  const std::size_t bytes = std::size_t(n) * n * n * sizeof(Real);
+
+  Real *fields[5];
+  for (auto &f : fields) {
+    f = static_cast<Real *>(PORTABLE_MALLOC(bytes));
+  }
+  PortableMDArray<Real> rho(fields[0], n, n, n), sie(fields[1], n, n, n);
+  PortableMDArray<Real> press(fields[2], n, n, n), temp(fields[3], n, n, n);
+  PortableMDArray<Real> bulk(fields[4], n, n, n);
+  portableFor(
+      "init", 0, n, 0, n, 0, n, PORTABLE_LAMBDA(const int k, const int j, const int i) {
+        rho(k, j, i) = 1 + 1e-3 * (i + j + k);
+        sie(k, j, i) = 2 + 1e-3 * (i - j + k);
+      });
+  PORTABLE_FENCE();
+
+  constexpr Real gm1 = 0.4, cv = 1.5, gamma = 1.4;
+  const auto pressure = PORTABLE_LAMBDA(const int k, const int j, const int i) {
+    press(k, j, i) = gm1 * rho(k, j, i) * sie(k, j, i);
+  };
+  const auto temperature = PORTABLE_LAMBDA(const int k, const int j, const int i) {
+    temp(k, j, i) = sie(k, j, i) / cv;
+  };
+  const auto bulk_modulus = PORTABLE_LAMBDA(const int k, const int j, const int i) {
+    bulk(k, j, i) = gamma * gm1 * rho(k, j, i) * sie(k, j, i);
+  };
+
+  const double separate = BestSeconds(repetitions, [&]() {
+    portableFor("pressure", 0, n, 0, n, 0, n, pressure);
+    portableFor("temperature", 0, n, 0, n, 0, n, temperature);
+    portableFor("bulk modulus", 0, n, 0, n, 0, n, bulk_modulus);
+  });
+  const double fused = BestSeconds(repetitions, [&]() {
+    portableForFused("eos", 0, n, 0, n, 0, n, pressure, temperature, bulk_modulus);
+  });
+
+  // compulsory traffic, ignoring write-allocate reads
+  const double separate_bytes = 8.0 * bytes, fused_bytes = 5.0 * bytes;
+  std::printf("n = %d, %d repetitions, best time\n", n, repetitions);
+  std::printf("%-10s %12s %14s %16s\n", "variant", "time [ms]", "traffic [GB]",
+              "bandwidth [GB/s]");
+  std::printf("%-10s %12.3f %14.3f %16.2f\n", "separate", 1e3 * separate,
+              separate_bytes / 1e9, separate_bytes / separate / 1e9);
+  std::printf("%-10s %12.3f %14.3f %16.2f\n", "fused", 1e3 * fused, fused_bytes / 1e9,
+              fused_bytes / fused / 1e9);
+  std::printf("speedup %.2fx (ideal for memory-bound kernels %.2fx)\n", separate / fused,
+              separate_bytes / fused_bytes);
+
+  for (auto &f : fields) {
+    PORTABLE_FREE(f);
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+
+// This file was generated in part with generative AI
+
+// A "cycle" of small dependent kernels on one execution space
+// instance, issued launch by launch and as a replayed Graph. At small
+// sizes the cost is dominated by launching, which is what the graph
+// amortizes.
+//
+// usage: bench_graph [n = 1000] [kernels per cycle = 20] [cycles = 2000]
+
+#include <ports-of-call/portability.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char *argv[]) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::ScopeGuard guard(argc, argv);
+#endif
+  const int n = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const int nkernels = argc > 2 ? std::atoi(argv[2]) : 20;
+  const int ncycles = argc > 3 ? std::atoi(argv[3]) : 2000;
+  using PortsOfCall::Exec::Device;
+
+  Real *const x = static_cast<Real *>(PORTABLE_MALLOC(n * sizeof(Real)));
+  portableFor(
+      "init", 0, n, PORTABLE_LAMBDA(const int i) { x[i] = i; });
+  PORTABLE_FENCE();
+  const auto kernel = PORTABLE_LAMBDA(const int i) { x[i] = 0.5 * x[i] + 1; };
+  const Device stream = PortsOfCall::MakeInstances(Device(), 1)[0];
+
+  const auto time = [&](const auto &cycle) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < ncycles; ++c) {
+      cycle();
+    }
+    PORTABLE_FENCE(stream);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (double(ncycles) * nkernels);
+  };
+
+  const double launches = time([&]() {
+    for (int k = 0; k < nkernels; ++k) {
+      portableFor("kernel", stream, 0, n, kernel);
+    }
+  });
+  PortsOfCall::Graph<Device> graph(stream);
+  for (int k = 0; k < nkernels; ++k) {
+    graph.AddFor("kernel", 0, n, kernel);
+  }
+  graph.Instantiate();
+  const double replayed = time([&]() { graph.Submit(); });
+
+  std::printf("n = %d, %d kernels per cycle, %d cycles\n", n, nkernels, ncycles);
+  std::printf("%-10s %18s\n", "variant", "per kernel [us]");
+  std::printf("%-10s %18.3f\n", "launches", 1e6 * launches);
+  std::printf("%-10s %18.3f\n", "graph", 1e6 * replayed);
+  std::printf("speedup %.2fx\n", launches / replayed);
+
+  PORTABLE_FREE(x);
+  return 0;
+}
@@ -0,0 +1,132 @@
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+
+// This file was generated in part with generative AI
+
+// The effect of alignment and huge pages on a large table, as used
+// for tabulated equations of state. For each allocation option a
+// table of the given size is filled, then read with random lookups,
+// where nearly every lookup misses the TLB on 4 KiB pages, and
+// streamed, which shows the bandwidth. The pages column reports what
+// was obtained: explicit huge pages fall back to transparent ones when
+// none are reserved (see /proc/sys/vm/nr_hugepages), and transparent
+// huge pages depend on /sys/kernel/mm/transparent_hugepage/enabled.
+//
+// usage: bench_pages [table MiB = 1024] [lookups = 1 << 24] [repetitions = 5]
+
+#include <ports-of-call/portability.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+template <typename Run>
+double BestSeconds(int repetitions, const Run &run) {
+  double best = std::numeric_limits<double>::max();
+  for (int r = 0; r < repetitions; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    PORTABLE_FENCE();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+const char *PagesName(PortsOfCall::HugePages pages) {
+  switch (pages) {
+  case PortsOfCall::HugePages::Transparent:
+    return "transparent";
+  case PortsOfCall::HugePages::Explicit:
+    return "hugetlbfs";
+  default:
+    return "4 KiB";
+  }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::ScopeGuard guard(argc, argv);
+#endif
+  using PortsOfCall::HugePages;
+  using PortsOfCall::MallocOptions;
+  using PortsOfCall::Exec::HostParallel;
+  const std::int64_t mib = argc > 1 ? std::atoll(argv[1]) : 1024;
+  const std::int64_t lookups = argc > 2 ? std::atoll(argv[2]) : 1 << 24;
+  const int repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+  const std::int64_t n = (mib << 20) / sizeof(double);
+
+  struct Variant {
+    const char *name;
+    MallocOptions options;
+  };
+  const Variant variants[] = {
+      {"malloc", {}},
+      {"aligned 64", {.alignment = 64}},
+      {"aligned 4K", {.alignment = 4096}},
+      {"transparent huge", {.huge_pages = HugePages::Transparent}},
+      {"explicit huge", {.huge_pages = HugePages::Explicit}},
+  };
+
+  std::printf("table %lld MiB, %lld lookups, %d repetitions, best time\n",
+              static_cast<long long>(mib), static_cast<long long>(lookups), repetitions);
+  std::printf("%-18s %-12s %14s %18s\n", "allocation", "pages", "lookup [ns]",
+              "stream [GB/s]");
+  double checksum = 0;
+  for (const auto &variant : variants) {
+    double *const table = static_cast<double *>(PortsOfCall::portableMalloc(
+        HostParallel(), n * sizeof(double), variant.options));
+    if (table == nullptr) {
+      std::printf("%-18s allocation failed\n", variant.name);
+      continue;
+    }
+    portableFor(
+        "fill", HostParallel(), std::int64_t(0), n,
+        PORTABLE_LAMBDA(const std::int64_t i) { table[i] = 1e-3 * (i % 1000); });
+    PORTABLE_FENCE();
+
+    double sum = 0;
+    const double lookup = BestSeconds(repetitions, [&]() {
+      sum = 0;
+      portableReduce(
+          "lookup", HostParallel(), std::int64_t(0), lookups,
+          PORTABLE_LAMBDA(const std::int64_t k, double &s) {
+            // a multiplicative hash spreads lookups over the whole table
+            const std::uint64_t h = static_cast<std::uint64_t>(k) * 0x9E3779B97F4A7C15ull;
+            s += table[(h >> 11) % static_cast<std::uint64_t>(n)];
+          },
+          sum);
+    });
+    checksum += sum;
+    const double stream = BestSeconds(repetitions, [&]() {
+      sum = 0;
+      portableReduce(
+          "stream", HostParallel(), std::int64_t(0), n,
+          PORTABLE_LAMBDA(const std::int64_t i, double &s) { s += table[i]; }, sum);
+    });
+    checksum += sum;
+
+    std::printf("%-18s %-12s %14.2f %18.2f\n", variant.name,
+                PagesName(PortsOfCall::impl::HostAllocator::PagesOf(table)),
+                1e9 * lookup / lookups, n * sizeof(double) / stream / 1e9);
+    PortsOfCall::portableFree(HostParallel(), table);
+  }
+  std::printf("checksum %g\n", checksum);
+  return 0;
+}
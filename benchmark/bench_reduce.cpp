@@ -0,0 +1,103 @@
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+
+// This file was generated in part with generative AI
+
+// The cost of Deterministic reductions. Sums n doubles on HostParallel
+// with the ordinary reduction and in Deterministic mode with several
+// chunk sizes, and, on host backends, checks whether each result
+// changes when the reduction runs on a single thread.
+//
+// usage: bench_reduce [n = 1 << 24] [repetitions = 20]
+
+#include <ports-of-call/portability.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+template <typename Run>
+double BestSeconds(int repetitions, const Run &run) {
+  double best = std::numeric_limits<double>::max();
+  for (int r = 0; r < repetitions; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    PORTABLE_FENCE();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+// Runs sum on one thread, where the host backends allow choosing
+template <typename Sum>
+double OnOneThread(const Sum &sum) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  return sum();
+#else
+  const PortsOfCall::impl::ScopedConcurrency concurrency(1);
+  return sum();
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::ScopeGuard guard(argc, argv);
+#endif
+  using PortsOfCall::Exec::HostParallel;
+  const int n = argc > 1 ? std::atoi(argv[1]) : 1 << 24;
+  const int repetitions = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  std::vector<double> values(n);
+  for (int i = 0; i < n; ++i) {
+    values[i] = (i % 7 == 0 ? 1e8 : 1e-3) * (i % 2 ? -1.0 : 1.0) + 1e-6 * i;
+  }
+  const double *const v = values.data();
+  const auto body = PORTABLE_LAMBDA(const int i, double &s) { s += v[i]; };
+
+  std::printf("n = %d, %d repetitions, best time\n", n, repetitions);
+  std::printf("%-20s %10s %8s %18s %24s %9s\n", "mode", "time [ms]", "cost",
+              "bandwidth [GB/s]", "sum", "1 thread");
+  double fast = 0;
+  const auto report = [&](const char *mode, const auto &sum) {
+    const double seconds = BestSeconds(repetitions, sum);
+    if (fast == 0) fast = seconds;
+    const double all = sum(), one = OnOneThread(sum);
+    std::printf("%-20s %10.3f %7.2fx %18.2f %24.17g %9s\n", mode, 1e3 * seconds,
+                seconds / fast, n * sizeof(double) / seconds / 1e9, all,
+                all == one ? "same" : "differs");
+  };
+
+  report("fast", [&]() {
+    double sum = 0;
+    portableReduce("fast", HostParallel(), 0, n, body, sum);
+    return sum;
+  });
+  for (const int chunk : {256, 1024, 4096, 16384}) {
+    char mode[32];
+    std::snprintf(mode, sizeof(mode), "deterministic %d", chunk);
+    report(mode, [&]() {
+      double sum = 0;
+      portableReduce("deterministic", HostParallel(), PortsOfCall::Deterministic{chunk},
+                     0, n, body, sum);
+      return sum;
+    });
+  }
+  return 0;
+}
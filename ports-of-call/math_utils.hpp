@@ -64,11 +64,18 @@ PORTABLE_FORCEINLINE_FUNCTION constexpr auto power(BaseT const &base,
 }
 // Overload for non-arithmetic bases or exponents
 template <typename BaseT, typename ExponentT>
-  requires(!Robust::arithmetic_like<BaseT> || !Robust::arithmetic_like<ExponentT>)
+  requires((!Robust::arithmetic_like<BaseT> || !Robust::arithmetic_like<ExponentT>) &&
+           !is_simd_v<BaseT> && !is_simd_v<ExponentT>)
 PORTABLE_FORCEINLINE_FUNCTION constexpr auto power(BaseT const &base,
                                                    ExponentT const &exponent) {
   return std::pow(base, exponent);
 }
+// Lane by lane for SIMD packs, using the scalar overloads above
+template <typename BaseT, typename ExponentT>
+  requires(is_simd_v<BaseT> || is_simd_v<ExponentT>)
+PORTABLE_FORCEINLINE_FUNCTION auto power(BaseT const &base, ExponentT const &exponent) {
+  return SimdMap([](const auto b, const auto e) { return power(b, e); }, base, exponent);
+}
 
 template <typename Value>
 struct plus {
@@ -91,7 +98,7 @@ PORTABLE_FUNCTION constexpr Value accumulate(IterB begin, IterE end, Value accum
 PORTABLE_FORCEINLINE_FUNCTION float expm1(float x) {
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   return Kokkos::expm1(x);
-#elif defined(PORTABILITY_STRATEGY_NONE)
+#elif defined(PORTABILITY_STRATEGY_NONE) || defined(PORTABILITY_STRATEGY_OPENMP)
   return std::expm1(x);
 #else
   return expm1f(x);
@@ -101,7 +108,7 @@ PORTABLE_FORCEINLINE_FUNCTION float expm1(float x) {
 PORTABLE_FORCEINLINE_FUNCTION double expm1(double x) {
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   return Kokkos::expm1(x);
-#elif defined(PORTABILITY_STRATEGY_NONE)
+#elif defined(PORTABILITY_STRATEGY_NONE) || defined(PORTABILITY_STRATEGY_OPENMP)
   return std::expm1(x);
 #else
   return expm1(x);
@@ -18,67 +18,26 @@
 
 // This file was generated in part with generative AI
 
+#include <algorithm>
+#include <bit>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
-#include <ports-of-call/portable_config.hpp>
+#include <ports-of-call/portability/strategy.hpp>
 
-#ifdef PORTABILITY_STRATEGY_KOKKOS
-#ifdef PORTABILITY_STRATEGY_CUDA
-#error "Two or more portability strategies defined."
-#endif // PORTABILITY_STRATEGY_CUDA
-#ifdef PORTABILITY_STRATEGY_NONE
-#error "Two or more portability strategies defined."
-#endif // PORTABILITY_STRATEGY_NONE
-#endif // PORTABILITY_STRATEGY_KOKKOS
+#if defined(PORTABILITY_STRATEGY_NONE) || defined(PORTABILITY_STRATEGY_OPENMP)
+#include <ports-of-call/portability/host_stream.hpp>
+#include <ports-of-call/portability/md_range.hpp>
+#endif // PORTABILITY_STRATEGY_NONE || PORTABILITY_STRATEGY_OPENMP
 
-#ifdef PORTABILITY_STRATEGY_CUDA
-#ifdef PORTABILITY_STRATEGY_NONE
-#error "Two or more portability strategies defined."
-#endif // PORTABILITY_STRATEGY_NONE
-#endif // PORTABILITY_STRATEGY_CUDA
-
-// if no portability strategy defined, define none
-#if !(defined PORTABILITY_STRATEGY_CUDA || defined PORTABILITY_STRATEGY_KOKKOS)
-#ifndef PORTABILITY_STRATEGY_NONE
-#define PORTABILITY_STRATEGY_NONE
-#endif // none not defined
-#endif
-
-#ifdef PORTABILITY_STRATEGY_KOKKOS
-#include "Kokkos_Core.hpp"
-#define PORTABLE_FUNCTION KOKKOS_FUNCTION
-#define PORTABLE_INLINE_FUNCTION KOKKOS_INLINE_FUNCTION
-#define PORTABLE_FORCEINLINE_FUNCTION KOKKOS_FORCEINLINE_FUNCTION
-#define PORTABLE_LAMBDA KOKKOS_LAMBDA
-#define _WITH_KOKKOS_
-// Do we want to include additional terms here (for memory spaces, etc.)?
-#define PORTABLE_FENCE(...) Kokkos::fence(__VA_ARGS__)
-#else
-#ifdef PORTABILITY_STRATEGY_CUDA
-// currently error out on cuda since its not implemented
-#error "CUDA portability strategy not yet implemented"
-#include "cuda.h"
-#define PORTABLE_FUNCTION __host__ __device__
-#define PORTABLE_INLINE_FUNCTION __host__ __device__ inline
-#define PORTABLE_FORCEINLINE_FUNCTION __host__ __device__ POC_ALWAYS_INLINE
-#define PORTABLE_LAMBDA [=] __host__ __device__
-#define PORTABLE_FENCE(...) cudaDeviceSynchronize()
-#define _WITH_CUDA_
-// It is worth noting here that we will not define
-// _WITH_CUDA_ when we are doing KOKKOS (even with the
-// CUDA backend)  Rely on KOKKOS_HAVE_CUDA in that case
-#else
-#define PORTABLE_FUNCTION
-#define PORTABLE_INLINE_FUNCTION inline
-#define PORTABLE_FORCEINLINE_FUNCTION POC_ALWAYS_INLINE
-#define PORTABLE_LAMBDA [=]
-#define PORTABLE_FENCE(...)
-#endif
-#endif
 #define PORTABLE_MALLOC(...) PortsOfCall::portableMalloc<>(__VA_ARGS__)
 #define PORTABLE_FREE(...) PortsOfCall::portableFree(__VA_ARGS__)
 
@@ -92,6 +51,16 @@ typedef float Real;
 typedef double Real;
 #endif
 
+#include <ports-of-call/portability/reducers.hpp>
+#include <ports-of-call/portability/team.hpp>
+#include <ports-of-call/portability/timing.hpp>
+#include <ports-of-call/portability/memory_pool.hpp>
+#include <ports-of-call/portability/host_alloc.hpp>
+#include <ports-of-call/portability/memory_tracker.hpp>
+#include <ports-of-call/portability/simd.hpp>
+
+#include <ports-of-call/portable_errors.hpp>
+
 namespace PortsOfCall {
 // compile-time constant to check if execution of memory space
 // will be done on the host or is offloaded
@@ -101,88 +70,1051 @@ constexpr bool EXECUTION_IS_HOST{
                                Kokkos::HostSpace>::accessible};
 #elif defined(PORTABILITY_STRATEGY_CUDA)
 constexpr bool EXECUTION_IS_HOST{false};
-#else
+#else // NONE, OPENMP
 constexpr bool EXECUTION_IS_HOST{true};
 #endif
 
+// Host is always a valid place to run host code. Without Kokkos it is
+// a plain serial loop, which is handy for debugging. HostParallel
+// splits host loops across threads: it is Kokkos' default host space
+// under Kokkos, OpenMP threads under OpenMP and the ports-of-call
+// thread pool otherwise. Under OpenMP, Device also means OpenMP threads.
+//
+// A default-constructed space runs launches synchronously. Instances
+// from MakeInstances carry a stream: launches on them are queued and
+// run in order, asynchronously, on the stream's thread.
 namespace Exec {
 #ifdef PORTABILITY_STRATEGY_KOKKOS
 using Device = Kokkos::DefaultExecutionSpace;
 using Host = Kokkos::DefaultHostExecutionSpace;
+using HostParallel = Kokkos::DefaultHostExecutionSpace;
 #else  // otherwise
-struct Device {};
-struct Host {};
+struct Device {
+  std::shared_ptr<impl::HostStream> stream;
+};
+struct Host {
+  std::shared_ptr<impl::HostStream> stream;
+};
+struct HostParallel {
+  std::shared_ptr<impl::HostStream> stream;
+};
 #endif // PORTABILITY_STRATEGY_KOKKOS
 } // namespace Exec
 
-// portable printf
-#define PORTABLE_MAX_NUM_CHAR (2048)
+#ifdef PORTABILITY_STRATEGY_NONE
+namespace impl {
+template <typename E>
+constexpr bool is_host_parallel_v = std::is_same_v<E, Exec::HostParallel>;
+} // namespace impl
+#endif // PORTABILITY_STRATEGY_NONE
+
+#ifdef PORTABILITY_STRATEGY_OPENMP
+namespace impl {
+template <typename E>
+constexpr bool is_openmp_v =
+    std::is_same_v<E, Exec::Device> || std::is_same_v<E, Exec::HostParallel>;
+} // namespace impl
+#endif // PORTABILITY_STRATEGY_OPENMP
+
+// Tile extents for the tiled overloads of portableFor, slowest index
+// first like the loop bounds. An extent of 0 lets the backend choose.
+// e.g., portableFor(name, e, TileSizes{4, 8, 64}, ...);
+template <std::size_t N>
+struct TileSizes {
+  int extent[N];
+};
 template <typename... Ts>
-PORTABLE_INLINE_FUNCTION void printf(char const *const format, Ts... ts) {
-  // disable for hip
-#ifndef __HIPCC__
-  if constexpr (sizeof...(Ts) > 0) {
-    std::printf(format, ts...);
+TileSizes(Ts...) -> TileSizes<sizeof...(Ts)>;
+
+// A loop dimension whose bounds are known at compile time. It takes
+// the place of a start, stop pair in portableFor, and is fully
+// unrolled:
+// e.g., portableFor(name, e, 0, nzones, StaticRange<0, 3>{}, f);
+template <int Begin, int End>
+struct StaticRange {
+  static_assert(Begin <= End, "StaticRange must not be reversed");
+  static constexpr int begin = Begin;
+  static constexpr int end = End;
+};
+
+// How the iterations of a portableFor or portableReduce are dealt out
+// to threads, passed after the execution space:
+// e.g., portableFor(name, e, Schedule::Dynamic(16), 0, n, f);
+// Static cuts the index space into one contiguous block per thread,
+// which is the default. Dynamic hands out chunks of chunk iterations
+// to whichever thread is free. Guided hands out chunks proportional to
+// the remaining work divided by the number of threads, but no smaller
+// than chunk.
+struct Schedule {
+  enum class Kind { Static, Dynamic, Guided };
+  Kind kind = Kind::Static;
+  std::int64_t chunk = 1;
+
+  static constexpr Schedule Static() { return {Kind::Static, 1}; }
+  static constexpr Schedule Dynamic(std::int64_t chunk = 1) {
+    return {Kind::Dynamic, chunk};
+  }
+  static constexpr Schedule Guided(std::int64_t min_chunk = 1) {
+    return {Kind::Guided, min_chunk};
+  }
+};
+
+// Reduction mode giving bitwise identical results for any number of
+// threads and on every host backend. The flattened index space is cut
+// into chunks of a fixed number of iterations, each chunk is reduced
+// in index order, and the chunk results are combined by a pairwise
+// tree whose shape depends only on the number of chunks. The result
+// does depend on chunk.
+struct Deterministic {
+  std::int64_t chunk = 1024;
+};
+
+namespace impl {
+// Index type of a 1D loop with bounds of types Start and Stop: int if
+// both convert to int without loss, std::int64_t otherwise.
+template <typename Start, typename Stop>
+using loop_index_t =
+    std::conditional_t<std::is_same_v<std::common_type_t<Start, Stop, int>, int>, int,
+                       std::int64_t>;
+
+// True if [start, stop) can be walked with an int index, which is
+// cheaper on GPUs and vectorizes better on CPUs.
+template <typename Start, typename Stop>
+constexpr bool FitsInInt(Start start, Stop stop) {
+  return std::in_range<int>(start) && std::in_range<int>(stop);
+}
+
+// The index types 1D loops are instantiated for
+template <typename Index>
+constexpr bool is_loop_index_v =
+    std::is_same_v<Index, int> || std::is_same_v<Index, std::int64_t>;
+
+// True for integer bounds that must first be converted to a loop index
+template <typename Start, typename Stop>
+constexpr bool needs_loop_index_v =
+    std::is_integral_v<Start> && std::is_integral_v<Stop> &&
+    !(std::is_same_v<Start, Stop> && is_loop_index_v<Start>);
+
+// Calls launch(start, stop) with both bounds converted to int if they
+// fit, and to std::int64_t otherwise
+template <typename Start, typename Stop, typename Launch>
+void WithLoopIndex(Start start, Stop stop, const Launch &launch) {
+  if (FitsInInt(start, stop)) {
+    launch(static_cast<int>(start), static_cast<int>(stop));
   } else {
-    std::printf("%s", format);
+    launch(static_cast<std::int64_t>(start), static_cast<std::int64_t>(stop));
   }
-#endif // __HIPCC__
-  return;
 }
-template <typename... Ts>
-PORTABLE_INLINE_FUNCTION void snprintf(char *target, std::size_t size,
-                                       char const *const format, Ts... ts) {
-#ifndef __HIPCC__
-  std::snprintf(target, size, format, ts...);
-#endif // __HIPCC__
-  return;
+
+// Calls each of several functors in turn with the same indices
+template <typename... Functions>
+struct FusedFunction;
+template <>
+struct FusedFunction<> {
+  template <typename... Indices>
+  PORTABLE_FORCEINLINE_FUNCTION void operator()(const Indices...) const {}
+};
+template <typename Function, typename... Rest>
+struct FusedFunction<Function, Rest...> {
+  Function head;
+  FusedFunction<Rest...> tail;
+  template <typename... Indices>
+  PORTABLE_FORCEINLINE_FUNCTION void operator()(const Indices... indices) const {
+    head(indices...);
+    tail(indices...);
+  }
+};
+inline FusedFunction<> Fuse() { return {}; }
+template <typename Function, typename... Rest>
+FusedFunction<Function, Rest...> Fuse(const Function &function, const Rest &...rest) {
+  return {function, Fuse(rest...)};
+}
+
+// Iteration k of a gathered loop calls function(indices[k]), after
+// handing the index distance iterations ahead to prefetch
+struct NoPrefetch {
+  PORTABLE_FORCEINLINE_FUNCTION void operator()(const int /*i*/) const {}
+};
+template <typename Function, typename Prefetch = NoPrefetch>
+struct GatherFunction {
+  const int *indices;
+  int n;
+  int distance;
+  Function function;
+  Prefetch prefetch;
+
+  PORTABLE_FORCEINLINE_FUNCTION void operator()(const int k) const {
+    if constexpr (!std::is_same_v<Prefetch, NoPrefetch>) {
+      if (k < n - distance) prefetch(indices[k + distance]);
+    }
+    function(indices[k]);
+  }
+};
+
+template <typename T>
+struct is_tile_sizes : std::false_type {};
+template <std::size_t N>
+struct is_tile_sizes<TileSizes<N>> : std::true_type {};
+
+// Number of leading arguments that are loop bounds or tile sizes
+template <typename... Args>
+constexpr std::size_t LeadingBounds() {
+  constexpr bool bound[] = {(std::is_arithmetic_v<std::decay_t<Args>> ||
+                             is_tile_sizes<std::decay_t<Args>>::value)...,
+                            false};
+  std::size_t n = 0;
+  while (bound[n]) {
+    n++;
+  }
+  return n;
+}
+
+template <typename T>
+struct is_static_range : std::false_type {};
+template <int Begin, int End>
+struct is_static_range<StaticRange<Begin, End>> : std::true_type {};
+template <typename T>
+struct is_integral_constant : std::false_type {};
+template <typename T, T V>
+struct is_integral_constant<std::integral_constant<T, V>> : std::true_type {};
+
+// Arguments that make a loop bound static
+template <typename T>
+constexpr bool is_static_bound_v = is_static_range<std::decay_t<T>>::value ||
+                                   is_integral_constant<std::decay_t<T>>::value;
+template <typename... Args>
+constexpr bool has_static_bound_v = (is_static_bound_v<Args> || ...);
+
+// The value of a bound, whether given as a number or an integral_constant
+template <typename T>
+PORTABLE_FORCEINLINE_FUNCTION constexpr auto BoundValue(const T &bound) {
+  if constexpr (is_integral_constant<T>::value) {
+    return T::value;
+  } else {
+    return bound;
+  }
+}
+
+template <typename T>
+constexpr int StaticBegin() {
+  if constexpr (is_static_range<T>::value) {
+    return T::begin;
+  } else if constexpr (is_integral_constant<T>::value) {
+    return static_cast<int>(T::value);
+  } else {
+    return 0;
+  }
+}
+template <typename T>
+constexpr int StaticEnd() {
+  if constexpr (is_static_range<T>::value) {
+    return T::end;
+  } else {
+    return 0;
+  }
 }
 
+// Which loop dimensions are static, where their bounds are and where
+// the bounds of the dynamic ones sit in the argument list.
+struct StaticLayout {
+  static constexpr int max_dims = 8;
+  int ndims = 0;
+  int nstatic = 0;
+  int ndynamic = 0;
+  bool is_static[max_dims] = {};
+  // per dimension, its position among the static or dynamic ones
+  int slot[max_dims] = {};
+  int static_begin[max_dims] = {};
+  int static_end[max_dims] = {};
+  int dynamic_arg[2 * max_dims] = {};
+};
+
+// The layout of bound arguments Args, in which a StaticRange or a pair
+// of integral_constants is one static dimension and any other pair of
+// arguments one dynamic dimension.
+template <typename... Args>
+constexpr StaticLayout MakeStaticLayout() {
+  constexpr std::size_t nargs = sizeof...(Args);
+  constexpr bool range[] = {is_static_range<std::decay_t<Args>>::value..., false};
+  constexpr bool constant[] = {is_integral_constant<std::decay_t<Args>>::value...,
+                               false};
+  constexpr int range_begin[] = {StaticBegin<std::decay_t<Args>>()..., 0};
+  constexpr int range_end[] = {StaticEnd<std::decay_t<Args>>()..., 0};
+  StaticLayout layout;
+  std::size_t a = 0;
+  while (a < nargs) {
+    const int d = layout.ndims++;
+    if (range[a] || (constant[a] && constant[a + 1])) {
+      layout.is_static[d] = true;
+      layout.slot[d] = layout.nstatic++;
+      layout.static_begin[layout.slot[d]] = range_begin[a];
+      layout.static_end[layout.slot[d]] = range[a] ? range_end[a] : range_begin[a + 1];
+      a += range[a] ? 1 : 2;
+    } else {
+      layout.slot[d] = layout.ndynamic++;
+      layout.dynamic_arg[2 * layout.slot[d]] = a;
+      layout.dynamic_arg[2 * layout.slot[d] + 1] = a + 1;
+      a += 2;
+    }
+  }
+  return layout;
+}
+
+// The n-th of a list of values
+template <int N, typename First, typename... Rest>
+PORTABLE_FORCEINLINE_FUNCTION auto Nth(const First &first, const Rest &...rest) {
+  if constexpr (N == 0) {
+    return first;
+  } else {
+    return Nth<N - 1>(rest...);
+  }
+}
+
+// Wraps a functor over all dimensions into one over the dynamic
+// dimensions, which unrolls the static dimensions inside. Static
+// indices are passed as std::integral_constant<int, i>.
+template <StaticLayout L, typename Function>
+struct StaticBoundsFunction {
+  Function function;
+
+  template <typename... Indices>
+  PORTABLE_FORCEINLINE_FUNCTION void operator()(const Indices... indices) const {
+    Unroll(std::integer_sequence<int>(), indices...);
+  }
+
+ private:
+  // S holds the values chosen so far for the outermost static dimensions
+  template <int... S, typename... Indices>
+  PORTABLE_FORCEINLINE_FUNCTION void Unroll(std::integer_sequence<int, S...>,
+                                            const Indices... indices) const {
+    constexpr int s = sizeof...(S);
+    if constexpr (s == L.nstatic) {
+      Call<S...>(std::make_index_sequence<L.ndims>(), indices...);
+    } else {
+      constexpr int begin = L.static_begin[s];
+      [&]<int... V>(std::integer_sequence<int, V...>) {
+        (Unroll(std::integer_sequence<int, S..., begin + V>(), indices...), ...);
+      }(std::make_integer_sequence<int, L.static_end[s] - begin>());
+    }
+  }
+
+  template <int... S, std::size_t... D, typename... Indices>
+  PORTABLE_FORCEINLINE_FUNCTION void Call(std::index_sequence<D...>,
+                                          const Indices... indices) const {
+    function(Index<D, S...>(indices...)...);
+  }
+
+  template <std::size_t D, int... S, typename... Indices>
+  PORTABLE_FORCEINLINE_FUNCTION static auto Index(const Indices... indices) {
+    if constexpr (L.is_static[D]) {
+      constexpr int values[] = {S...};
+      return std::integral_constant<int, values[L.slot[D]]>();
+    } else {
+      return Nth<L.slot[D]>(indices...);
+    }
+  }
+};
+
+// Stands in for a reducer when reducing into a bare T: partials start
+// value-initialized and are added up.
+template <typename T>
+struct Accumulator {
+  using value_type = T;
+  PORTABLE_INLINE_FUNCTION void init(T &v) const { v = T(); }
+  PORTABLE_INLINE_FUNCTION void join(T &dest, const T &src) const { dest += src; }
+};
+
+template <std::size_t... D, typename Index, typename Function, typename T>
+PORTABLE_FORCEINLINE_FUNCTION void CallWithIndices(std::index_sequence<D...>,
+                                                   const Index *outer, const Index i,
+                                                   const Function &function, T &value) {
+  function(outer[D]..., i, value);
+}
+
+// Reduces flattened iterations [begin, end) of the box [lo, hi) into
+// value, strictly in index order (last index fastest). The last index
+// runs in a plain inner loop, into a local copy of value, so that the
+// loop is as tight as in the other reductions.
+template <std::size_t N, typename Index, typename Function, typename T>
+PORTABLE_INLINE_FUNCTION void ReduceFlatChunk(const Index *lo, const Index *hi,
+                                              std::int64_t begin, std::int64_t end,
+                                              const Function &function, T &value) {
+  Index idx[N];
+  std::int64_t rest = begin;
+  for (int d = N - 1; d >= 0; --d) {
+    const std::int64_t extent = hi[d] - lo[d];
+    idx[d] = lo[d] + static_cast<Index>(rest % extent);
+    rest /= extent;
+  }
+  T local = value;
+  for (std::int64_t k = begin; k < end;) {
+    const std::int64_t run = std::min<std::int64_t>(end - k, hi[N - 1] - idx[N - 1]);
+    const Index first = idx[N - 1];
+    const Index stop = first + static_cast<Index>(run);
+    for (Index i = first; i < stop; ++i) {
+      CallWithIndices(std::make_index_sequence<N - 1>(), idx, i, function, local);
+    }
+    k += run;
+    idx[N - 1] = lo[N - 1];
+    for (int d = static_cast<int>(N) - 2; d >= 0; --d) {
+      if (++idx[d] < hi[d]) break;
+      idx[d] = lo[d];
+    }
+  }
+  value = local;
+}
+
+// Joins partials[0, n) into partials[0] pairwise, (0 1) (2 3) ...
+// then (01 23) ..., a tree fixed by n alone
+template <typename Reducer, typename T>
+void TreeReduce(const Reducer &reducer, T *partials, std::int64_t n) {
+  for (std::int64_t stride = 1; stride < n; stride *= 2) {
+    for (std::int64_t i = 0; i + stride < n; i += 2 * stride) {
+      reducer.join(partials[i], partials[i + stride]);
+    }
+  }
+}
+} // namespace impl
+
+#if defined(PORTABILITY_STRATEGY_NONE) || defined(PORTABILITY_STRATEGY_OPENMP)
+namespace impl {
 template <typename E>
-inline auto portableMalloc([[maybe_unused]] E e, std::size_t size_bytes) {
+const std::shared_ptr<HostStream> *StreamOf(const E &e) {
+  if constexpr (requires { e.stream; }) {
+    return e.stream ? &e.stream : nullptr;
+  } else {
+    return nullptr;
+  }
+}
+
+// If e has a stream, queue launch(name, E()) on it and return true.
+// The launch replays against a default-constructed, synchronous E on
+// the stream's thread.
+template <typename E, typename Launch>
+bool LaunchOnStream(const E &e, const char *name, const Launch &launch) {
+  const auto *stream = StreamOf(e);
+  if (stream == nullptr) return false;
+  (*stream)->Enqueue(
+      [launch, label = std::string(name)]() { launch(label.c_str(), E()); });
+  return true;
+}
+
+// Blocking operations on an instance first wait for its queued work
+template <typename E>
+void SyncStream(const E &e) {
+  if (const auto *stream = StreamOf(e)) (*stream)->Fence();
+}
+
+// Number of threads a host loop launched on E is spread over
+template <typename E>
+int HostConcurrency() {
+#ifdef PORTABILITY_STRATEGY_OPENMP
+  return is_openmp_v<E> ? omp_get_max_threads() : 1;
+#else
+  return is_host_parallel_v<E> ? ThreadPool::Global().Concurrency() : 1;
+#endif // PORTABILITY_STRATEGY_OPENMP
+}
+
+// While in scope, parallel host loops launched from this thread use at
+// most nthreads threads. 0 leaves the thread count alone.
+class ScopedConcurrency {
+ public:
+  explicit ScopedConcurrency(int nthreads) {
+#ifdef PORTABILITY_STRATEGY_OPENMP
+    previous_ = omp_get_max_threads();
+    if (nthreads > 0) omp_set_num_threads(nthreads);
+#else
+    previous_ = ThreadPool::ConcurrencyLimit();
+    if (nthreads > 0) ThreadPool::SetConcurrencyLimit(nthreads);
+#endif // PORTABILITY_STRATEGY_OPENMP
+  }
+  ~ScopedConcurrency() {
+#ifdef PORTABILITY_STRATEGY_OPENMP
+    omp_set_num_threads(previous_);
+#else
+    ThreadPool::SetConcurrencyLimit(previous_);
+#endif // PORTABILITY_STRATEGY_OPENMP
+  }
+  ScopedConcurrency(const ScopedConcurrency &) = delete;
+  ScopedConcurrency &operator=(const ScopedConcurrency &) = delete;
+
+ private:
+  int previous_;
+};
+
+// Calls block_function(b) for every b in [0, nblocks) on the threads
+// implied by E, statically assigning contiguous blocks to threads.
+template <typename E, typename BlockFunction>
+void ForEachHostBlock(std::int64_t nblocks, const BlockFunction &block_function) {
+#ifdef PORTABILITY_STRATEGY_OPENMP
+#pragma omp parallel for schedule(static) if (is_openmp_v<E>)
+  for (std::int64_t b = 0; b < nblocks; b++) {
+    block_function(b);
+  }
+#else
+  if constexpr (is_host_parallel_v<E>) {
+    ThreadPool::Global().ForEachBlock(nblocks, block_function);
+  } else {
+    for (std::int64_t b = 0; b < nblocks; b++) {
+      block_function(b);
+    }
+  }
+#endif // PORTABILITY_STRATEGY_OPENMP
+}
+
+// Visit the index space tile by tile, whole tiles per thread
+template <typename E, std::size_t N, typename Function>
+void TiledFor(const TileSizes<N> &tiles, const int (&lo)[N], const int (&hi)[N],
+              const Function &function) {
+  const TiledMDRange<N> tiled = MakeTiledRange(lo, hi, tiles.extent);
+  const std::int64_t ntiles = tiled.NumTiles();
+  const std::int64_t nblocks = std::min<std::int64_t>(ntiles, HostConcurrency<E>());
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(ntiles, nblocks, b);
+    for (std::int64_t t = begin; t < end; t++) {
+      ForEachInTile(tiled, t, function);
+    }
+  });
+}
+
+// Reduce with one or more reducers: each block starts from the
+// reducers' identities, and the partial results are joined in block
+// order before being written through the reducers' references.
+template <typename E, std::size_t N, typename Index, typename Function,
+          typename... Reducers>
+void ReduceWith(const Index (&lo)[N], const Index (&hi)[N], const Function &function,
+                const Reducers &...reducers) {
+  using Values = std::tuple<typename Reducers::value_type...>;
+  constexpr auto Is = std::index_sequence_for<Reducers...>();
+  auto init = [&](Values &values) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (reducers.init(std::get<I>(values)), ...);
+    }(Is);
+  };
+  MDRange<N, Index> range;
+  std::copy(lo, lo + N, range.lo);
+  std::copy(hi, hi + N, range.hi);
+  const std::int64_t n = range.Size();
+  const std::int64_t nblocks =
+      std::max<std::int64_t>(1, std::min<std::int64_t>(n, HostConcurrency<E>()));
+  std::vector<Values> partials(nblocks);
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(n, nblocks, b);
+    Values local;
+    init(local);
+    std::apply(
+        [&](auto &...values) {
+          ForEachInFlatRange(range, begin, end, function, values...);
+        },
+        local);
+    partials[b] = local;
+  });
+  Values result;
+  init(result);
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    for (std::int64_t b = 0; b < nblocks; b++) {
+      (reducers.join(std::get<I>(result), std::get<I>(partials[b])), ...);
+    }
+    ((reducers.reference() = std::get<I>(result)), ...);
+  }(Is);
+  (Finalize(reducers), ...);
+}
+
+// Deals [0, n) out in chunks claimed from a shared counter by nblocks
+// threads, calling chunk_function(b, begin, end) for every chunk, with
+// b the claiming thread's block. Threads that finish early simply
+// claim more, so uneven iterations balance out.
+template <typename E, typename ChunkFunction>
+void ForEachHostChunk(const Schedule &schedule, std::int64_t n, std::int64_t nblocks,
+                      const ChunkFunction &chunk_function) {
+  const std::int64_t min_chunk = std::max<std::int64_t>(1, schedule.chunk);
+  std::atomic<std::int64_t> next{0};
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    while (true) {
+      std::int64_t begin, size;
+      if (schedule.kind == Schedule::Kind::Guided) {
+        begin = next.load(std::memory_order_relaxed);
+        do {
+          size = std::max(min_chunk, (n - begin) / (2 * nblocks));
+        } while (begin < n && !next.compare_exchange_weak(begin, begin + size,
+                                                           std::memory_order_relaxed));
+      } else {
+        size = min_chunk;
+        begin = next.fetch_add(size, std::memory_order_relaxed);
+      }
+      if (begin >= n) break;
+      chunk_function(b, begin, std::min(n, begin + size));
+    }
+  });
+}
+
+template <typename E, std::size_t N, typename Index, typename Function>
+void ScheduledFor(const Schedule &schedule, const Index (&lo)[N], const Index (&hi)[N],
+                  const Function &function) {
+  MDRange<N, Index> range;
+  std::copy(lo, lo + N, range.lo);
+  std::copy(hi, hi + N, range.hi);
+  const std::int64_t n = range.Size();
+  const std::int64_t nblocks =
+      std::max<std::int64_t>(1, std::min<std::int64_t>(n, HostConcurrency<E>()));
+  ForEachHostChunk<E>(schedule, n, nblocks,
+                      [&](std::int64_t /*b*/, std::int64_t begin, std::int64_t end) {
+                        ForEachInFlatRange(range, begin, end, function);
+                      });
+}
+
+// As ReduceWith, but the chunks are scheduled and the result is
+// returned rather than written. Each chunk is reduced into a fresh
+// partial that is joined into its thread's, so the order in which
+// floating point partials combine depends on the timing of the run.
+template <typename E, std::size_t N, typename Index, typename Function,
+          typename... Reducers>
+auto ScheduledReduce(const Schedule &schedule, const Index (&lo)[N], const Index (&hi)[N],
+                     const Function &function, const Reducers &...reducers) {
+  using Values = std::tuple<typename Reducers::value_type...>;
+  constexpr auto Is = std::index_sequence_for<Reducers...>();
+  auto init = [&](Values &values) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (reducers.init(std::get<I>(values)), ...);
+    }(Is);
+  };
+  auto join = [&](Values &dest, const Values &src) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (reducers.join(std::get<I>(dest), std::get<I>(src)), ...);
+    }(Is);
+  };
+  MDRange<N, Index> range;
+  std::copy(lo, lo + N, range.lo);
+  std::copy(hi, hi + N, range.hi);
+  const std::int64_t n = range.Size();
+  const std::int64_t nblocks =
+      std::max<std::int64_t>(1, std::min<std::int64_t>(n, HostConcurrency<E>()));
+  std::vector<Values> partials(nblocks);
+  for (auto &partial : partials) {
+    init(partial);
+  }
+  ForEachHostChunk<E>(schedule, n, nblocks,
+                      [&](std::int64_t b, std::int64_t begin, std::int64_t end) {
+                        Values local;
+                        init(local);
+                        std::apply(
+                            [&](auto &...values) {
+                              ForEachInFlatRange(range, begin, end, function, values...);
+                            },
+                            local);
+                        join(partials[b], local);
+                      });
+  Values result;
+  init(result);
+  for (const auto &partial : partials) {
+    join(result, partial);
+  }
+  return result;
+}
+
+// Two-pass blocked scan. The first pass computes each block's sum
+// (final = false), a short serial pass turns those into block offsets,
+// and the second pass rescans each block from its offset with
+// final = true. With a single block only the second pass is needed.
+template <typename E, typename Index, typename Function, typename T>
+void Scan(Index start, Index stop, const Function &function, T &total) {
+  const std::int64_t n = std::max<std::int64_t>(0, stop - start);
+  const std::int64_t nblocks =
+      std::max<std::int64_t>(1, std::min<std::int64_t>(n, HostConcurrency<E>()));
+  std::vector<T> offsets(nblocks, T());
+  if (nblocks > 1) {
+    ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+      const auto [begin, end] = BlockBounds(n, nblocks, b);
+      T partial = T();
+      for (Index i = start + begin; i < start + end; i++) {
+        function(i, partial, false);
+      }
+      offsets[b] = partial;
+    });
+    T running = T();
+    for (std::int64_t b = 0; b < nblocks; b++) {
+      const T block_sum = offsets[b];
+      offsets[b] = running;
+      running += block_sum;
+    }
+  }
+  std::vector<T> ends(nblocks, T());
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(n, nblocks, b);
+    T partial = offsets[b];
+    for (Index i = start + begin; i < start + end; i++) {
+      function(i, partial, true);
+    }
+    ends[b] = partial;
+  });
+  total = ends[nblocks - 1];
+}
+
+// One team per league rank, teams dealt out in contiguous blocks. Each
+// block owns a scratch buffer that its teams reuse in turn.
+template <typename E, typename Function>
+void TeamFor(int league_size, std::size_t scratch_bytes, const Function &function) {
+  const std::int64_t n = std::max(0, league_size);
+  const std::int64_t nblocks = std::min<std::int64_t>(n, HostConcurrency<E>());
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(n, nblocks, b);
+    const std::size_t nwords =
+        (scratch_bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+    std::unique_ptr<std::max_align_t[]> scratch(new std::max_align_t[nwords]);
+    for (std::int64_t t = begin; t < end; t++) {
+      const HostTeamMember member(static_cast<int>(t), league_size, scratch.get(),
+                                  scratch_bytes);
+      function(member);
+    }
+  });
+}
+} // namespace impl
+#endif // PORTABILITY_STRATEGY_NONE || PORTABILITY_STRATEGY_OPENMP
+
+// Hint that the memory at p will be read soon, e.g. from the prefetch
+// functor of portableForIndices. Does nothing on devices.
+PORTABLE_FORCEINLINE_FUNCTION void Prefetch([[maybe_unused]] const void *p) {
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDA_ARCH__) &&              \
+    !defined(__HIP_DEVICE_COMPILE__) && !defined(__SYCL_DEVICE_ONLY__)
+  __builtin_prefetch(p);
+#endif
+}
+
+// Options for portableMalloc
+struct MallocOptions {
+  // Zero the memory in parallel, split over the threads of the
+  // execution space as a static portableFor over it would be, so that
+  // on a NUMA node each page is placed in the memory of the socket
+  // whose threads will work on it. Host memory only.
+  bool first_touch = false;
+  // Align the memory to this power of two, e.g. 64 for cache lines
+  // and aligned vector loads, 4096 for pages or 2 MiB for huge pages.
+  // 0 leaves the allocator's alignment. Host memory only.
+  std::size_t alignment = 0;
+  // Back the memory with 2 MiB pages, to cut TLB misses on large
+  // tables (see host_alloc.hpp). Host memory only.
+  HugePages huge_pages = HugePages::None;
+  // Shown next to the allocation in memory reports, if tracking is on
+  // (see memory_tracker.hpp). Copied, so it may be temporary.
+  const char *label = nullptr;
+};
+
+namespace impl {
+// Zeroes size_bytes at p, split into contiguous blocks the way a 1D
+// portableFor on e over the same range would be. Pages belong to the
+// NUMA domain of the thread that first writes them.
+template <typename E>
+void FirstTouch([[maybe_unused]] const E &e, void *p, std::size_t size_bytes) {
+  char *const bytes = static_cast<char *>(p);
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using memory_space = typename E::memory_space;
+  if constexpr (Kokkos::SpaceAccessibility<Kokkos::DefaultHostExecutionSpace,
+                                          memory_space>::accessible &&
+                Kokkos::SpaceAccessibility<E, Kokkos::HostSpace>::accessible) {
+    Kokkos::parallel_for(
+        "PortsOfCall::FirstTouch", Kokkos::RangePolicy<E>(e, 0, size_bytes),
+        KOKKOS_LAMBDA(const std::size_t i) { bytes[i] = 0; });
+    e.fence();
+  }
+#else
+  const std::int64_t n = static_cast<std::int64_t>(size_bytes);
+  const std::int64_t nblocks = HostConcurrency<E>();
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(n, nblocks, b);
+    std::memset(bytes + begin, 0, end - begin);
+  });
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+} // namespace impl
+
+namespace impl {
+// The memory space execution space E allocates in. One memory pool
+// serves each.
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+template <typename E>
+using memory_space_t = typename E::memory_space;
+#elif defined(PORTABILITY_STRATEGY_CUDA)
+template <typename E>
+using memory_space_t = E;
+#else
+// every space allocates ordinary host memory
+struct HostMemory {};
+template <typename E>
+using memory_space_t = HostMemory;
+#endif // PORTABILITY STRATEGY
+
+template <typename Space>
+void *RawMalloc(std::size_t size_bytes) {
   void *ret;
 #ifdef PORTABILITY_STRATEGY_KOKKOS
-  ret = Kokkos::kokkos_malloc<typename E::memory_space>(size_bytes);
+  ret = Kokkos::kokkos_malloc<Space>(size_bytes);
 #elif defined(PORTABILITY_STRATEGY_CUDA)
-  if constexpr (std::is_same_v < E, Exec::Device) {
+  if constexpr (std::is_same_v < Space, Exec::Device) {
     cudaError_t e = cudaMalloc(&ret, size_bytes);
-  } else if constexpr (std::is_same_v < E, Exec::Host) {
+  } else if constexpr (std::is_same_v < Space, Exec::Host) {
     ret = malloc(size_bytes);
   } else {
     throw
   }
-#else  // PORTABILITY_STRATEGY_NONE
+#else  // PORTABILITY_STRATEGY_NONE, PORTABILITY_STRATEGY_OPENMP
   ret = std::malloc(size_bytes);
 #endif // PORTABILITY STRATEGY
   return ret;
 }
-template <typename E = Exec::Device>
-inline auto portableMalloc(std::size_t size_bytes) {
-  return portableMalloc(E(), size_bytes);
-}
 
-template <typename E, typename T>
-void portableFree([[maybe_unused]] E e, T *p) {
+template <typename Space>
+void RawFree(void *p) {
 #ifdef PORTABILITY_STRATEGY_KOKKOS
-  Kokkos::kokkos_free<typename E::memory_space>(p);
+  Kokkos::kokkos_free<Space>(p);
 #elif defined(PORTABILITY_STRATEGY_CUDA)
-  if constexpr (std::is_same_v<E, Device>) {
+  if constexpr (std::is_same_v<Space, Device>) {
     cudaError_t e = cudaFree(p);
   } else {
     std::free(p);
   }
-#else  // PORTABILITY_STRATEGY_NONE
+#else  // PORTABILITY_STRATEGY_NONE, PORTABILITY_STRATEGY_OPENMP
   std::free(p);
 #endif // PORTABILITY STRATEGY
 }
+
+// True if memory in Space is ordinary host memory
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+template <typename Space>
+constexpr bool is_host_memory_v = std::is_same_v<Space, Kokkos::HostSpace>;
+#elif defined(PORTABILITY_STRATEGY_CUDA)
+template <typename Space>
+constexpr bool is_host_memory_v = std::is_same_v<Space, Exec::Host>;
+#else
+template <typename Space>
+constexpr bool is_host_memory_v = true;
+#endif // PORTABILITY STRATEGY
+
+// Waits for work that may still use memory in Space, before the pool
+// recycles a block of it; nullptr where freeing does not wait either
+template <typename Space>
+constexpr MemoryPool::FenceFunction RecycleFence() {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  return []() { Kokkos::fence("PortsOfCall::MemoryPool::Free"); };
+#elif defined(PORTABILITY_STRATEGY_CUDA)
+  if constexpr (std::is_same_v<Space, Exec::Device>) {
+    return []() { cudaDeviceSynchronize(); };
+  } else {
+    return nullptr;
+  }
+#else
+  return nullptr;
+#endif // PORTABILITY STRATEGY
+}
+
+template <typename Space>
+MemoryPool &GlobalPool() {
+  static MemoryPool *pool = []() {
+    static MemoryPool instance(&RawMalloc<Space>, &RawFree<Space>, RecycleFence<Space>());
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    // cached blocks must go back before Kokkos shuts down
+    Kokkos::push_finalize_hook([]() { instance.Trim(); });
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    return &instance;
+  }();
+  return *pool;
+}
+
+template <typename Space>
+std::string SpaceName() {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  return Space::name();
+#elif defined(PORTABILITY_STRATEGY_CUDA)
+  return is_host_memory_v<Space> ? "Host" : "Device";
+#else
+  return "Host";
+#endif // PORTABILITY STRATEGY
+}
+template <typename Space>
+MemoryTracker &GlobalTracker() {
+  static MemoryTracker &tracker = MemoryTrackers::Get().Add(SpaceName<Space>());
+  return tracker;
+}
+template <typename Space>
+void TrackMalloc(void *p, std::size_t size_bytes, const char *label) {
+  if (p != nullptr && MemoryTracking::Enabled()) {
+    GlobalTracker<Space>().Track(p, size_bytes, label);
+  }
+}
+} // namespace impl
+
+// Allocation statistics for the memory of e, when tracking is on
+template <typename E = Exec::Device>
+MemoryStats MemoryStatsOf([[maybe_unused]] const E &e = E()) {
+  return impl::GlobalTracker<impl::memory_space_t<E>>().Stats();
+}
+
+// The memory pool behind portableMalloc and portableFree on e
+template <typename E = Exec::Device>
+MemoryPool &MemoryPoolOf([[maybe_unused]] const E &e = E()) {
+  return impl::GlobalPool<impl::memory_space_t<E>>();
+}
+
+template <typename E>
+inline auto portableMalloc([[maybe_unused]] E e, std::size_t size_bytes) {
+  using Space = impl::memory_space_t<E>;
+  void *ret = impl::GlobalPool<Space>().Allocate(size_bytes);
+  impl::TrackMalloc<Space>(ret, size_bytes, nullptr);
+  return ret;
+}
+template <typename E = Exec::Device>
+inline auto portableMalloc(std::size_t size_bytes) {
+  return portableMalloc(E(), size_bytes);
+}
+// Alignment and huge pages bypass the memory pool, and are ignored
+// for device memory
+template <typename E>
+inline auto portableMalloc(E e, std::size_t size_bytes, const MallocOptions &options) {
+  using Space = impl::memory_space_t<E>;
+  PORTABLE_ALWAYS_REQUIRE(options.alignment == 0 ||
+                              std::has_single_bit(options.alignment),
+                          "MallocOptions::alignment must be a power of two");
+  void *ret = nullptr;
+  bool direct = false;
+  if constexpr (impl::is_host_memory_v<Space>) {
+    direct = options.alignment > 0 || options.huge_pages != HugePages::None;
+  }
+  // a failed aligned allocation returns nullptr rather than memory
+  // without the alignment asked for
+  if (direct) {
+    ret = impl::HostAllocator::Allocate(size_bytes, options.alignment,
+                                        options.huge_pages);
+  } else {
+    ret = impl::GlobalPool<Space>().Allocate(size_bytes);
+  }
+  impl::TrackMalloc<Space>(ret, size_bytes, options.label);
+  if (options.first_touch && ret != nullptr) impl::FirstTouch(e, ret, size_bytes);
+  return ret;
+}
+template <typename E = Exec::Device>
+inline auto portableMalloc(std::size_t size_bytes, const MallocOptions &options) {
+  return portableMalloc(E(), size_bytes, options);
+}
+
+template <typename E, typename T>
+void portableFree([[maybe_unused]] E e, T *p) {
+  using Space = impl::memory_space_t<E>;
+  impl::GlobalTracker<Space>().Untrack(p);
+  if constexpr (impl::is_host_memory_v<Space>) {
+    if (impl::HostAllocator::Free(p)) return;
+  }
+  impl::GlobalPool<Space>().Free(p);
+}
 template <typename T>
 void portableFree(T *p) {
   portableFree(Exec::Device(), p);
 }
 
+// n independent instances of e, each with its own queue of work (a
+// stream). Under Kokkos this is Kokkos::Experimental::partition_space.
+template <typename E>
+std::vector<E> MakeInstances(const E &e, int n) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  return Kokkos::Experimental::partition_space(e, std::vector<int>(n, 1));
+#else
+  std::vector<E> instances(n, e);
+  for (auto &instance : instances) {
+    instance.stream = impl::HostStream::Create();
+  }
+  return instances;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+namespace impl {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+inline void Fence() { Kokkos::fence(); }
+inline void Fence(const std::string &label) { Kokkos::fence(label); }
+template <typename E,
+          typename = std::enable_if_t<!std::is_convertible_v<const E &, std::string>>>
+void Fence(const E &e, const std::string &label = "PortsOfCall::Fence") {
+  e.fence(label);
+}
+#else
+// A global fence waits for every stream
+inline void Fence([[maybe_unused]] std::string_view label = {}) {
+  HostStream::FenceAll();
+#ifdef PORTABILITY_STRATEGY_OPENMP
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif // PORTABILITY_STRATEGY_OPENMP
+}
+template <typename E, typename = std::enable_if_t<
+                          !std::is_convertible_v<const E &, std::string_view>>>
+void Fence(const E &e, [[maybe_unused]] std::string_view label = {}) {
+  SyncStream(e);
+#ifdef PORTABILITY_STRATEGY_OPENMP
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif // PORTABILITY_STRATEGY_OPENMP
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+} // namespace impl
+
+// Marks a point in an instance's queue of work. Record captures
+// everything submitted to the instance so far, Wait blocks the host
+// until that work is done, and portableWaitEvent makes later work on
+// another instance wait for it. Kokkos has no portable cross-instance
+// event, so there both wait by fencing the recorded instance.
+template <typename E = Exec::Device>
+class Event {
+ public:
+  void Record(const E &e) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    instance_ = e;
+    recorded_ = true;
+#else
+    const auto *stream = impl::StreamOf(e);
+    stream_ = stream ? *stream : nullptr;
+    ticket_ = stream_ ? stream_->Submitted() : 0;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  }
+
+  void Wait() const {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    if (recorded_) instance_.fence("PortsOfCall::Event::Wait");
+#else
+    if (stream_) stream_->Wait(ticket_);
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  }
+
+  // Work submitted to instance after this call starts only once the
+  // recorded work is done. Does not block the host unless instance is
+  // synchronous.
+  template <typename Instance>
+  void EnqueueWait(const Instance &instance) const {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    (void)instance;
+    Wait();
+#else
+    const auto *waiter = impl::StreamOf(instance);
+    if (waiter == nullptr) {
+      Wait();
+    } else if (stream_ && stream_ != *waiter) {
+      (*waiter)->Enqueue(
+          [stream = stream_, ticket = ticket_]() { stream->WaitQuietly(ticket); });
+    }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  }
+
+ private:
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  E instance_;
+  bool recorded_ = false;
+#else
+  std::shared_ptr<impl::HostStream> stream_;
+  std::uint64_t ticket_ = 0;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+};
+
+template <typename Instance, typename E>
+void portableWaitEvent(const Instance &instance, const Event<E> &event) {
+  event.EnqueueWait(instance);
+}
+
 } // namespace PortsOfCall
 
-// TODO(JMM): Pass in exec space here later
 template <typename T>
 void portableCopyToDevice(T *const to, T const *const from, size_t const size_bytes) {
   auto const length = size_bytes / sizeof(T);
@@ -194,6 +1126,13 @@ void portableCopyToDevice(T *const to, T const *const from, size_t const size_by
   Kokkos::deep_copy(to_v, from_v);
 #elif defined(PORTABILITY_STRATEGY_CUDA)
   cudaMemcpy(to, from, size_bytes, cudaMemcpyHostToDevice);
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+  if (to != from) {
+#pragma omp parallel for simd
+    for (std::size_t i = 0; i < length; i++) {
+      to[i] = from[i];
+    }
+  }
 #else
   if (to != from) {
     std::copy(from, from + length, to);
@@ -213,6 +1152,13 @@ void portableCopyToHost(T *const to, T const *const from, size_t const size_byte
   Kokkos::deep_copy(to_v, from_v);
 #elif defined(PORTABILITY_STRATEGY_CUDA)
   cudaMemcpy(to, from, size_bytes, cudaMemcpyDeviceToHost);
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+  if (to != from) {
+#pragma omp parallel for simd
+    for (std::size_t i = 0; i < length; i++) {
+      to[i] = from[i];
+    }
+  }
 #else
   if (to != from) {
     std::copy(from, from + length, to);
@@ -221,33 +1167,131 @@ void portableCopyToHost(T *const to, T const *const from, size_t const size_byte
   return;
 }
 
-template <typename E, typename Function,
-          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+// Copies ordered with the other work on the instance e. They are
+// asynchronous with respect to the host when e carries a stream.
+template <typename E, typename T, typename = std::enable_if_t<!std::is_pointer_v<E>>>
+void portableCopyToDevice(const E &e, T *const to, T const *const from,
+                          size_t const size_bytes) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  auto const length = size_bytes / sizeof(T);
+  using UM = Kokkos::MemoryUnmanaged;
+  using HS = Kokkos::HostSpace;
+  Kokkos::View<const T *, HS, UM> from_v(from, length);
+  Kokkos::View<T *, typename E::memory_space, UM> to_v(to, length);
+  Kokkos::deep_copy(e, to_v, from_v);
+#else
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, "portableCopyToDevice", [=](const char * /*label*/, const auto & /*sync*/) {
+        portableCopyToDevice(to, from, size_bytes);
+      });
+  if (!queued) portableCopyToDevice(to, from, size_bytes);
+#endif
+}
+
+template <typename E, typename T, typename = std::enable_if_t<!std::is_pointer_v<E>>>
+void portableCopyToHost(const E &e, T *const to, T const *const from,
+                        size_t const size_bytes) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  auto const length = size_bytes / sizeof(T);
+  using UM = Kokkos::MemoryUnmanaged;
+  using HS = Kokkos::HostSpace;
+  Kokkos::View<const T *, typename E::memory_space, UM> from_v(from, length);
+  Kokkos::View<T *, HS, UM> to_v(to, length);
+  Kokkos::deep_copy(e, to_v, from_v);
+#else
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, "portableCopyToHost", [=](const char * /*label*/, const auto & /*sync*/) {
+        portableCopyToHost(to, from, size_bytes);
+      });
+  if (!queued) portableCopyToHost(to, from, size_bytes);
+#endif
+}
+
+// 1D loops run with an int or std::int64_t index, so they may exceed
+// 2^31 iterations. A 64-bit range that fits in an int takes the 32-bit
+// path, and other integer bounds are converted by the overload below.
+template <typename E, typename Index, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::is_loop_index_v<Index>>>
 void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
-                 int start, int stop, const Function &function) {
+                 Index start, Index stop, const Function &function) {
+  if constexpr (!std::is_same_v<Index, int>) {
+    if (PortsOfCall::impl::FitsInInt(start, stop)) {
+      portableFor(name, e, static_cast<int>(start), static_cast<int>(stop), function);
+      return;
+    }
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, start, stop, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(start, stop));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
-  using policy = Kokkos::RangePolicy<E>;
+  using policy = Kokkos::RangePolicy<E, Kokkos::IndexType<Index>>;
   Kokkos::parallel_for(name, policy(e, start, stop), function);
-#else
-  for (int i = start; i < stop; i++) {
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp parallel for if (PortsOfCall::impl::is_openmp_v<E>)
+  for (Index i = start; i < stop; i++) {
     function(i);
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelFor({start}, {stop}, function);
+  } else {
+    for (Index i = start; i < stop; i++) {
+      function(i);
+    }
+  }
 #endif
 }
 
+template <typename E, typename Start, typename Stop, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::needs_loop_index_v<Start, Stop>>>
+void portableFor(const char *name, const E &e, Start start, Stop stop,
+                 const Function &function) {
+  PortsOfCall::impl::WithLoopIndex(start, stop, [&](auto lo, auto hi) {
+    portableFor(name, e, lo, hi, function);
+  });
+}
+
 template <typename E, typename Function,
           typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
 void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                  int starty, int stopy, int startx, int stopx, const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, starty, stopy, startx, stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(starty, stopy, startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy2D = Kokkos::MDRangePolicy<E, Kokkos::Rank<2>>;
   Kokkos::parallel_for(name, Policy2D(e, {starty, startx}, {stopy, stopx}), function);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp parallel for collapse(2) if (PortsOfCall::impl::is_openmp_v<E>)
   for (int iy = starty; iy < stopy; iy++) {
     for (int ix = startx; ix < stopx; ix++) {
       function(iy, ix);
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelFor({starty, startx}, {stopy, stopx}, function);
+  } else {
+    for (int iy = starty; iy < stopy; iy++) {
+      for (int ix = startx; ix < stopx; ix++) {
+        function(iy, ix);
+      }
+    }
+  }
 #endif
 }
 
@@ -256,11 +1300,22 @@ template <typename E, typename Function,
 void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                  int startz, int stopz, int starty, int stopy, int startx, int stopx,
                  const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, startz, stopz, starty, stopy, startx, stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startz, stopz, starty, stopy, startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy3D = Kokkos::MDRangePolicy<E, Kokkos::Rank<3>>;
   Kokkos::parallel_for(name, Policy3D(e, {startz, starty, startx}, {stopz, stopy, stopx}),
                        function);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp parallel for collapse(3) if (PortsOfCall::impl::is_openmp_v<E>)
   for (int iz = startz; iz < stopz; iz++) {
     for (int iy = starty; iy < stopy; iy++) {
       for (int ix = startx; ix < stopx; ix++) {
@@ -268,6 +1323,19 @@ void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
       }
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelFor({startz, starty, startx},
+                                   {stopz, stopy, stopx}, function);
+  } else {
+    for (int iz = startz; iz < stopz; iz++) {
+      for (int iy = starty; iy < stopy; iy++) {
+        for (int ix = startx; ix < stopx; ix++) {
+          function(iz, iy, ix);
+        }
+      }
+    }
+  }
 #endif
 }
 
@@ -276,12 +1344,25 @@ template <typename E = PortsOfCall::Exec::Device, typename Function,
 void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                  int starta, int stopa, int startz, int stopz, int starty, int stopy,
                  int startx, int stopx, const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, starta, stopa, startz, stopz, starty, stopy, startx,
+                    stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(starta, stopa, startz, stopz, starty, stopy,
+                                        startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy4D = Kokkos::MDRangePolicy<E, Kokkos::Rank<4>>;
   Kokkos::parallel_for(
       name, Policy4D(e, {starta, startz, starty, startx}, {stopa, stopz, stopy, stopx}),
       function);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp parallel for collapse(4) if (PortsOfCall::impl::is_openmp_v<E>)
   for (int ia = starta; ia < stopa; ia++) {
     for (int iz = startz; iz < stopz; iz++) {
       for (int iy = starty; iy < stopy; iy++) {
@@ -291,6 +1372,21 @@ void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
       }
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelFor({starta, startz, starty, startx},
+                                   {stopa, stopz, stopy, stopx}, function);
+  } else {
+    for (int ia = starta; ia < stopa; ia++) {
+      for (int iz = startz; iz < stopz; iz++) {
+        for (int iy = starty; iy < stopy; iy++) {
+          for (int ix = startx; ix < stopx; ix++) {
+            function(ia, iz, iy, ix);
+          }
+        }
+      }
+    }
+  }
 #endif
 }
 
@@ -299,13 +1395,26 @@ template <typename E, typename Function,
 void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                  int startb, int stopb, int starta, int stopa, int startz, int stopz,
                  int starty, int stopy, int startx, int stopx, const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, startb, stopb, starta, stopa, startz, stopz, starty,
+                    stopy, startx, stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startb, stopb, starta, stopa, startz, stopz,
+                                        starty, stopy, startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy5D = Kokkos::MDRangePolicy<E, Kokkos::Rank<5>>;
   Kokkos::parallel_for(name,
                        Policy5D(e, {startb, starta, startz, starty, startx},
                                 {stopb, stopa, stopz, stopy, stopx}),
                        function);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp parallel for collapse(5) if (PortsOfCall::impl::is_openmp_v<E>)
   for (int ib = startb; ib < stopb; ib++) {
     for (int ia = starta; ia < stopa; ia++) {
       for (int iz = startz; iz < stopz; iz++) {
@@ -317,58 +1426,358 @@ void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
       }
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelFor({startb, starta, startz, starty, startx},
+                                   {stopb, stopa, stopz, stopy, stopx}, function);
+  } else {
+    for (int ib = startb; ib < stopb; ib++) {
+      for (int ia = starta; ia < stopa; ia++) {
+        for (int iz = startz; iz < stopz; iz++) {
+          for (int iy = starty; iy < stopy; iy++) {
+            for (int ix = startx; ix < stopx; ix++) {
+              function(ib, ia, iz, iy, ix);
+            }
+          }
+        }
+      }
+    }
+  }
+#endif
+}
+
+// Tiled variants of the multi-dimensional loops. The index space is
+// walked tile by tile, and lexicographically within each tile, which
+// keeps the working set of stencil-like kernels in cache. Under Kokkos
+// the tile extents are handed to MDRangePolicy.
+template <typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                 const PortsOfCall::TileSizes<2> &tiles, int starty, int stopy,
+                 int startx, int stopx, const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, tiles, starty, stopy, startx, stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(starty, stopy, startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy2D = Kokkos::MDRangePolicy<E, Kokkos::Rank<2>>;
+  Kokkos::parallel_for(name,
+                       Policy2D(e, {starty, startx}, {stopy, stopx},
+                                {tiles.extent[0], tiles.extent[1]}),
+                       function);
+#else
+  PortsOfCall::impl::TiledFor<E>(tiles, {starty, startx}, {stopy, stopx}, function);
+#endif
+}
+
+template <typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                 const PortsOfCall::TileSizes<3> &tiles, int startz, int stopz,
+                 int starty, int stopy, int startx, int stopx,
+                 const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, tiles, startz, stopz, starty, stopy, startx, stopx,
+                    function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startz, stopz, starty, stopy, startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy3D = Kokkos::MDRangePolicy<E, Kokkos::Rank<3>>;
+  Kokkos::parallel_for(name,
+                       Policy3D(e, {startz, starty, startx}, {stopz, stopy, stopx},
+                                {tiles.extent[0], tiles.extent[1], tiles.extent[2]}),
+                       function);
+#else
+  PortsOfCall::impl::TiledFor<E>(tiles, {startz, starty, startx}, {stopz, stopy, stopx},
+                                 function);
+#endif
+}
+
+template <typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                 const PortsOfCall::TileSizes<4> &tiles, int starta, int stopa,
+                 int startz, int stopz, int starty, int stopy, int startx, int stopx,
+                 const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, tiles, starta, stopa, startz, stopz, starty, stopy,
+                    startx, stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(starta, stopa, startz, stopz, starty, stopy,
+                                        startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy4D = Kokkos::MDRangePolicy<E, Kokkos::Rank<4>>;
+  Kokkos::parallel_for(name,
+                       Policy4D(e, {starta, startz, starty, startx},
+                                {stopa, stopz, stopy, stopx},
+                                {tiles.extent[0], tiles.extent[1], tiles.extent[2],
+                                 tiles.extent[3]}),
+                       function);
+#else
+  PortsOfCall::impl::TiledFor<E>(tiles, {starta, startz, starty, startx},
+                                 {stopa, stopz, stopy, stopx}, function);
+#endif
+}
+
+template <typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                 const PortsOfCall::TileSizes<5> &tiles, int startb, int stopb,
+                 int starta, int stopa, int startz, int stopz, int starty, int stopy,
+                 int startx, int stopx, const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, tiles, startb, stopb, starta, stopa, startz, stopz,
+                    starty, stopy, startx, stopx, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startb, stopb, starta, stopa, startz, stopz,
+                                        starty, stopy, startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy5D = Kokkos::MDRangePolicy<E, Kokkos::Rank<5>>;
+  Kokkos::parallel_for(name,
+                       Policy5D(e, {startb, starta, startz, starty, startx},
+                                {stopb, stopa, stopz, stopy, stopx},
+                                {tiles.extent[0], tiles.extent[1], tiles.extent[2],
+                                 tiles.extent[3], tiles.extent[4]}),
+                       function);
+#else
+  PortsOfCall::impl::TiledFor<E>(tiles, {startb, starta, startz, starty, startx},
+                                 {stopb, stopa, stopz, stopy, stopx}, function);
 #endif
 }
 
 template <typename Head, typename... Tail,
-          typename = std::enable_if_t<std::is_arithmetic_v<Head>>>
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
 void portableFor([[maybe_unused]] const char *name, Head &&h, Tail &&...tail) {
   portableFor(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
 }
 
-template <typename E, typename Function, typename T,
+// Calls function once per pack of W consecutive indices in [start,
+// stop), passing a PortsOfCall::SimdIndex<W>. Only the last pack may be
+// partial, in which case its mask covers the indices in range. Packs
+// are distributed like the iterations of a portableFor.
+template <int W = PortsOfCall::simd_width_v<Real>, typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableForSimd(const char *name, const E &e, int start, int stop,
+                     const Function &function) {
+  static_assert(W > 0, "SIMD width must be positive");
+  const int npacks = (std::max(0, stop - start) + W - 1) / W;
+  portableFor(
+      name, e, 0, npacks, PORTABLE_LAMBDA(const int p) {
+        const int first = start + p * W;
+        function(PortsOfCall::SimdIndex<W>(first, std::min(W, stop - first)));
+      });
+}
+
+template <int W = PortsOfCall::simd_width_v<Real>, typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableForSimd(const char *name, Head &&h, Tail &&...tail) {
+  portableForSimd<W>(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
+}
+
+// Runs several loop bodies over the same index space in one traversal:
+//   portableForFused(name, e, bounds..., f1, f2, ...);
+// accepts anything portableFor does before its functor (bounds of any
+// rank, tile sizes) and calls f1, f2, ... in order at each index. A
+// body may use what earlier bodies wrote at the same index, but not at
+// other indices, as there is no synchronization between bodies.
+template <typename E, typename... Args,
           typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableForFused(const char *name, const E &e, const Args &...args) {
+  constexpr std::size_t nbounds = PortsOfCall::impl::LeadingBounds<Args...>();
+  constexpr std::size_t nfunctions = sizeof...(Args) - nbounds;
+  static_assert(nbounds > 0 && nfunctions > 0,
+                "portableForFused takes loop bounds followed by loop bodies");
+  const auto all = std::forward_as_tuple(args...);
+  [&]<std::size_t... B, std::size_t... F>(std::index_sequence<B...>,
+                                          std::index_sequence<F...>) {
+    portableFor(name, e, std::get<B>(all)...,
+                PortsOfCall::impl::Fuse(std::get<nbounds + F>(all)...));
+  }(std::make_index_sequence<nbounds>(), std::make_index_sequence<nfunctions>());
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableForFused(const char *name, Head &&h, Tail &&...tail) {
+  portableForFused(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
+}
+
+// Loops in which some dimensions have compile-time bounds, given as a
+// StaticRange<Begin, End> or a pair of std::integral_constants. The
+// dynamic dimensions are launched as a portableFor of their rank, and
+// within each of their iterations the static dimensions are fully
+// unrolled. The functor receives each static index as a
+// std::integral_constant<int, i>, which converts to int.
+template <typename E, typename... Args,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::has_static_bound_v<Args...>>>
+void portableFor(const char *name, const E &e, const Args &...args) {
+  const auto all = std::forward_as_tuple(args...);
+  constexpr std::size_t nbounds = sizeof...(Args) - 1;
+  using Function = std::decay_t<std::tuple_element_t<nbounds, std::tuple<Args...>>>;
+  constexpr PortsOfCall::impl::StaticLayout layout = [&]<std::size_t... A>(
+      std::index_sequence<A...>) {
+    return PortsOfCall::impl::MakeStaticLayout<
+        std::tuple_element_t<A, std::tuple<Args...>>...>();
+  }(std::make_index_sequence<nbounds>());
+  static_assert(layout.ndims <= PortsOfCall::impl::StaticLayout::max_dims,
+                "Too many loop dimensions");
+  static_assert(layout.ndynamic <= 5, "At most five dynamic loop dimensions");
+  const PortsOfCall::impl::StaticBoundsFunction<layout, Function> function{
+      std::get<nbounds>(all)};
+  if constexpr (layout.ndynamic == 0) {
+    portableFor(
+        name, e, 0, 1, PORTABLE_LAMBDA(const int /*i*/) { function(); });
+  } else {
+    [&]<std::size_t... B>(std::index_sequence<B...>) {
+      portableFor(name, e,
+                  PortsOfCall::impl::BoundValue(std::get<layout.dynamic_arg[B]>(all))...,
+                  function);
+    }(std::make_index_sequence<2 * layout.ndynamic>());
+  }
+}
+
+template <typename Head, typename... Tail,
+          std::enable_if_t<PortsOfCall::impl::is_static_bound_v<Head>, int> = 0>
+void portableFor(const char *name, Head &&h, Tail &&...tail) {
+  portableFor(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
+}
+
+template <typename E, typename Index, typename Function, typename T,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::is_loop_index_v<Index> &&
+                                      !PortsOfCall::is_reducer_v<T>>>
 void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
-                    int start, int stop, const Function &function, T &reduced) {
+                    Index start, Index stop, const Function &function, T &reduced) {
+  if constexpr (!std::is_same_v<Index, int>) {
+    if (PortsOfCall::impl::FitsInInt(start, stop)) {
+      portableReduce(name, e, static_cast<int>(start), static_cast<int>(stop), function,
+                     reduced);
+      return;
+    }
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(start, stop));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
-  using Policy = Kokkos::RangePolicy<E>;
+  using Policy = Kokkos::RangePolicy<E, Kokkos::IndexType<Index>>;
   Kokkos::parallel_reduce(name, Policy(e, start, stop), function, reduced);
-#else
-  for (int i = start; i < stop; i++) {
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp declare reduction(poc_sum : T : omp_out += omp_in)                           \
+    initializer(omp_priv = T())
+#pragma omp parallel for reduction(poc_sum : reduced)                                    \
+    if (PortsOfCall::impl::is_openmp_v<E>)
+  for (Index i = start; i < stop; i++) {
     function(i, reduced);
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelReduce({start}, {stop}, function, reduced);
+  } else {
+    for (Index i = start; i < stop; i++) {
+      function(i, reduced);
+    }
+  }
 #endif
 }
 
+template <typename E, typename Start, typename Stop, typename Function, typename T,
+          typename = std::enable_if_t<
+              !std::is_arithmetic_v<E> &&
+              PortsOfCall::impl::needs_loop_index_v<Start, Stop> &&
+              !PortsOfCall::is_reducer_v<T>>>
+void portableReduce(const char *name, const E &e, Start start, Stop stop,
+                    const Function &function, T &reduced) {
+  PortsOfCall::impl::WithLoopIndex(start, stop, [&](auto lo, auto hi) {
+    portableReduce(name, e, lo, hi, function, reduced);
+  });
+}
+
 template <typename E, typename Function, typename T,
-          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      !PortsOfCall::is_reducer_v<T>>>
 void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                     int starty, int stopy, int startx, int stopx,
                     const Function &function, T &reduced) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(starty, stopy, startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy2D = Kokkos::MDRangePolicy<E, Kokkos::Rank<2>>;
   Kokkos::parallel_reduce(name, Policy2D(e, {starty, startx}, {stopy, stopx}), function,
                           reduced);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp declare reduction(poc_sum : T : omp_out += omp_in)                           \
+    initializer(omp_priv = T())
+#pragma omp parallel for collapse(2) reduction(poc_sum : reduced)                        \
+    if (PortsOfCall::impl::is_openmp_v<E>)
   for (int iy = starty; iy < stopy; iy++) {
     for (int ix = startx; ix < stopx; ix++) {
       function(iy, ix, reduced);
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelReduce({starty, startx}, {stopy, stopx}, function,
+                                      reduced);
+  } else {
+    for (int iy = starty; iy < stopy; iy++) {
+      for (int ix = startx; ix < stopx; ix++) {
+        function(iy, ix, reduced);
+      }
+    }
+  }
 #endif
 }
 
 template <typename E, typename Function, typename T,
-          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      !PortsOfCall::is_reducer_v<T>>>
 void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                     int startz, int stopz, int starty, int stopy, int startx, int stopx,
                     const Function &function, T &reduced) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startz, stopz, starty, stopy, startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy3D = Kokkos::MDRangePolicy<E, Kokkos::Rank<3>>;
   Kokkos::parallel_reduce(name,
                           Policy3D(e, {startz, starty, startx}, {stopz, stopy, stopx}),
                           function, reduced);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp declare reduction(poc_sum : T : omp_out += omp_in)                           \
+    initializer(omp_priv = T())
+#pragma omp parallel for collapse(3) reduction(poc_sum : reduced)                        \
+    if (PortsOfCall::impl::is_openmp_v<E>)
   for (int iz = startz; iz < stopz; iz++) {
     for (int iy = starty; iy < stopy; iy++) {
       for (int ix = startx; ix < stopx; ix++) {
@@ -376,20 +1785,45 @@ void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E
       }
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelReduce({startz, starty, startx}, {stopz, stopy, stopx},
+                                      function, reduced);
+  } else {
+    for (int iz = startz; iz < stopz; iz++) {
+      for (int iy = starty; iy < stopy; iy++) {
+        for (int ix = startx; ix < stopx; ix++) {
+          function(iz, iy, ix, reduced);
+        }
+      }
+    }
+  }
 #endif
 }
 
 template <typename E, typename Function, typename T,
-          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      !PortsOfCall::is_reducer_v<T>>>
 void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                     int starta, int stopa, int startz, int stopz, int starty, int stopy,
                     int startx, int stopx, const Function &function, T &reduced) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(starta, stopa, startz, stopz, starty, stopy,
+                                        startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy4D = Kokkos::MDRangePolicy<E, Kokkos::Rank<4>>;
   Kokkos::parallel_reduce(
       name, Policy4D(e, {starta, startz, starty, startx}, {stopa, stopz, stopy, stopx}),
       function, reduced);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp declare reduction(poc_sum : T : omp_out += omp_in)                           \
+    initializer(omp_priv = T())
+#pragma omp parallel for collapse(4) reduction(poc_sum : reduced)                        \
+    if (PortsOfCall::impl::is_openmp_v<E>)
   for (int ia = starta; ia < stopa; ia++) {
     for (int iz = startz; iz < stopz; iz++) {
       for (int iy = starty; iy < stopy; iy++) {
@@ -399,22 +1833,49 @@ void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E
       }
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelReduce({starta, startz, starty, startx},
+                                      {stopa, stopz, stopy, stopx}, function, reduced);
+  } else {
+    for (int ia = starta; ia < stopa; ia++) {
+      for (int iz = startz; iz < stopz; iz++) {
+        for (int iy = starty; iy < stopy; iy++) {
+          for (int ix = startx; ix < stopx; ix++) {
+            function(ia, iz, iy, ix, reduced);
+          }
+        }
+      }
+    }
+  }
 #endif
 }
 
 template <typename E, typename Function, typename T,
-          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      !PortsOfCall::is_reducer_v<T>>>
 void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
                     int startb, int stopb, int starta, int stopa, int startz, int stopz,
                     int starty, int stopy, int startx, int stopx,
                     const Function &function, T &reduced) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startb, stopb, starta, stopa, startz, stopz,
+                                        starty, stopy, startx, stopx));
 #ifdef PORTABILITY_STRATEGY_KOKKOS
   using Policy5D = Kokkos::MDRangePolicy<E, Kokkos::Rank<5>>;
   Kokkos::parallel_reduce(name,
                           Policy5D(e, {startb, starta, startz, starty, startx},
                                    {stopb, stopa, stopz, stopy, stopx}),
                           function, reduced);
-#else
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#pragma omp declare reduction(poc_sum : T : omp_out += omp_in)                           \
+    initializer(omp_priv = T())
+#pragma omp parallel for collapse(5) reduction(poc_sum : reduced)                        \
+    if (PortsOfCall::impl::is_openmp_v<E>)
   for (int ib = startb; ib < stopb; ib++) {
     for (int ia = starta; ia < stopa; ia++) {
       for (int iz = startz; iz < stopz; iz++) {
@@ -426,13 +1887,640 @@ void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E
       }
     }
   }
+#else
+  if constexpr (PortsOfCall::impl::is_host_parallel_v<E>) {
+    PortsOfCall::impl::ParallelReduce({startb, starta, startz, starty, startx},
+                                      {stopb, stopa, stopz, stopy, stopx}, function,
+                                      reduced);
+  } else {
+    for (int ib = startb; ib < stopb; ib++) {
+      for (int ia = starta; ia < stopa; ia++) {
+        for (int iz = startz; iz < stopz; iz++) {
+          for (int iy = starty; iy < stopy; iy++) {
+            for (int ix = startx; ix < stopx; ix++) {
+              function(ib, ia, iz, iy, ix, reduced);
+            }
+          }
+        }
+      }
+    }
+  }
+#endif
+}
+
+// Reductions with reducer objects (PortsOfCall::Sum, Min, MinLoc,
+// ...). Passing several reducers fuses the reductions into a single
+// traversal, with function taking one accumulator per reducer:
+// function(indices..., Reducers::value_type &...).
+template <typename E, typename Index, typename Function, typename... Reducers,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::is_loop_index_v<Index> &&
+                                      PortsOfCall::are_reducers_v<Reducers...>>>
+void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                    Index start, Index stop, const Function &function,
+                    const Reducers &...reducers) {
+  if constexpr (!std::is_same_v<Index, int>) {
+    if (PortsOfCall::impl::FitsInInt(start, stop)) {
+      portableReduce(name, e, static_cast<int>(start), static_cast<int>(stop), function,
+                     reducers...);
+      return;
+    }
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(start, stop));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy = Kokkos::RangePolicy<E, Kokkos::IndexType<Index>>;
+  PortsOfCall::impl::KokkosReduce(name, Policy(e, start, stop), function, reducers...);
+#else
+  PortsOfCall::impl::ReduceWith<E>({start}, {stop}, function, reducers...);
+#endif
+}
+
+template <typename E, typename Start, typename Stop, typename Function,
+          typename... Reducers,
+          typename = std::enable_if_t<
+              !std::is_arithmetic_v<E> &&
+              PortsOfCall::impl::needs_loop_index_v<Start, Stop> &&
+              PortsOfCall::are_reducers_v<Reducers...>>>
+void portableReduce(const char *name, const E &e, Start start, Stop stop,
+                    const Function &function, const Reducers &...reducers) {
+  PortsOfCall::impl::WithLoopIndex(start, stop, [&](auto lo, auto hi) {
+    portableReduce(name, e, lo, hi, function, reducers...);
+  });
+}
+
+template <typename E, typename Function, typename... Reducers,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::are_reducers_v<Reducers...>>>
+void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                    int starty, int stopy, int startx, int stopx,
+                    const Function &function, const Reducers &...reducers) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(starty, stopy, startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy2D = Kokkos::MDRangePolicy<E, Kokkos::Rank<2>>;
+  PortsOfCall::impl::KokkosReduce(name, Policy2D(e, {starty, startx}, {stopy, stopx}),
+                                  function, reducers...);
+#else
+  PortsOfCall::impl::ReduceWith<E>({starty, startx}, {stopy, stopx}, function,
+                                   reducers...);
+#endif
+}
+
+template <typename E, typename Function, typename... Reducers,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::are_reducers_v<Reducers...>>>
+void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                    int startz, int stopz, int starty, int stopy, int startx, int stopx,
+                    const Function &function, const Reducers &...reducers) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startz, stopz, starty, stopy, startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy3D = Kokkos::MDRangePolicy<E, Kokkos::Rank<3>>;
+  PortsOfCall::impl::KokkosReduce(
+      name, Policy3D(e, {startz, starty, startx}, {stopz, stopy, stopx}), function,
+      reducers...);
+#else
+  PortsOfCall::impl::ReduceWith<E>({startz, starty, startx}, {stopz, stopy, stopx},
+                                   function, reducers...);
+#endif
+}
+
+template <typename E, typename Function, typename... Reducers,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::are_reducers_v<Reducers...>>>
+void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                    int starta, int stopa, int startz, int stopz, int starty, int stopy,
+                    int startx, int stopx, const Function &function,
+                    const Reducers &...reducers) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(starta, stopa, startz, stopz, starty, stopy,
+                                        startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy4D = Kokkos::MDRangePolicy<E, Kokkos::Rank<4>>;
+  PortsOfCall::impl::KokkosReduce(
+      name, Policy4D(e, {starta, startz, starty, startx}, {stopa, stopz, stopy, stopx}),
+      function, reducers...);
+#else
+  PortsOfCall::impl::ReduceWith<E>({starta, startz, starty, startx},
+                                   {stopa, stopz, stopy, stopx}, function, reducers...);
+#endif
+}
+
+template <typename E, typename Function, typename... Reducers,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::are_reducers_v<Reducers...>>>
+void portableReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                    int startb, int stopb, int starta, int stopa, int startz, int stopz,
+                    int starty, int stopy, int startx, int stopx,
+                    const Function &function, const Reducers &...reducers) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e,
+      PortsOfCall::impl::IterationCount(startb, stopb, starta, stopa, startz, stopz,
+                                        starty, stopy, startx, stopx));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy5D = Kokkos::MDRangePolicy<E, Kokkos::Rank<5>>;
+  PortsOfCall::impl::KokkosReduce(name,
+                                  Policy5D(e, {startb, starta, startz, starty, startx},
+                                           {stopb, stopa, stopz, stopy, stopx}),
+                                  function, reducers...);
+#else
+  PortsOfCall::impl::ReduceWith<E>({startb, starta, startz, starty, startx},
+                                   {stopb, stopa, stopz, stopy, stopx}, function,
+                                   reducers...);
 #endif
 }
 
 template <typename Head, typename... Tail,
-          typename = std::enable_if_t<std::is_arithmetic_v<Head>>>
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
 void portableReduce([[maybe_unused]] const char *name, Head &&h, Tail &&...tail) {
   portableReduce(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
 }
 
+namespace PortsOfCall {
+namespace impl {
+// Splits interleaved bounds start0, stop0, start1, ... into lo and hi
+template <typename Index, std::size_t N, typename... Bounds>
+void SplitBounds(Index (&lo)[N], Index (&hi)[N], const Bounds... bounds) {
+  static_assert(sizeof...(Bounds) == 2 * N, "Loop bounds come in pairs");
+  const Index b[] = {static_cast<Index>(bounds)...};
+  for (std::size_t d = 0; d < N; ++d) {
+    lo[d] = b[2 * d];
+    hi[d] = b[2 * d + 1];
+  }
+}
+
+// Index type of a loop given its bounds: int, unless a bound needs 64
+// bits. Only arithmetic types count, so tile sizes may be among them.
+template <typename T>
+constexpr bool is_int_bound() {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return std::is_same_v<std::common_type_t<int, T>, int>;
+  } else {
+    return true;
+  }
+}
+template <typename... Bounds>
+using bounds_index_t =
+    std::conditional_t<(is_int_bound<std::decay_t<Bounds>>() && ...), int, std::int64_t>;
+
+// The index type for the first nbounds of a launch's arguments, so
+// that a bare T & being reduced into does not count as a bound
+template <typename Tuple, std::size_t... B>
+auto LeadingBoundsIndex(std::index_sequence<B...>)
+    -> bounds_index_t<std::tuple_element_t<B, Tuple>...>;
+template <std::size_t nbounds, typename... Args>
+using leading_bounds_index_t =
+    decltype(LeadingBoundsIndex<std::tuple<std::decay_t<Args>...>>(
+        std::make_index_sequence<nbounds>()));
+
+// The reduction of Deterministic mode, returned rather than written
+template <typename E, std::size_t N, typename Index, typename Function, typename Reducer>
+auto DeterministicReduce([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                         const Index (&lo)[N], const Index (&hi)[N], std::int64_t chunk,
+                         const Function &function, const Reducer &reducer) {
+  using T = typename Reducer::value_type;
+  std::int64_t n = 1;
+  for (std::size_t d = 0; d < N; ++d) {
+    n *= std::max<std::int64_t>(0, hi[d] - lo[d]);
+  }
+  chunk = std::max<std::int64_t>(1, chunk);
+  const std::int64_t nchunks = (n + chunk - 1) / chunk;
+  if (nchunks == 0) {
+    T empty;
+    reducer.init(empty);
+    return empty;
+  }
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::Array<Index, N> klo, khi;
+  for (std::size_t d = 0; d < N; ++d) {
+    klo[d] = lo[d];
+    khi[d] = hi[d];
+  }
+  Kokkos::View<T *, typename E::memory_space> partials(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "PortsOfCall::Deterministic"),
+      nchunks);
+  Kokkos::parallel_for(
+      name, Kokkos::RangePolicy<E, Kokkos::IndexType<std::int64_t>>(e, 0, nchunks),
+      KOKKOS_LAMBDA(const std::int64_t c) {
+        T value;
+        reducer.init(value);
+        ReduceFlatChunk<N>(klo.data(), khi.data(), c * chunk,
+                           Kokkos::min(n, (c + 1) * chunk), function, value);
+        partials(c) = value;
+      });
+  auto host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), partials);
+  TreeReduce(reducer, host.data(), nchunks);
+  return T(host(0));
+#else
+  const auto partials = std::make_unique<T[]>(nchunks);
+  const std::int64_t nblocks =
+      std::max<std::int64_t>(1, std::min<std::int64_t>(nchunks, HostConcurrency<E>()));
+  ForEachHostBlock<E>(nblocks, [&](std::int64_t b) {
+    const auto [first, last] = BlockBounds(nchunks, nblocks, b);
+    for (std::int64_t c = first; c < last; ++c) {
+      reducer.init(partials[c]);
+      ReduceFlatChunk<N>(lo, hi, c * chunk, std::min(n, (c + 1) * chunk), function,
+                         partials[c]);
+    }
+  });
+  TreeReduce(reducer, partials.get(), nchunks);
+  return T(partials[0]);
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+// A Kokkos policy with dynamic scheduling. Kokkos has no guided
+// schedule, so Guided is Dynamic with its minimum chunk.
+template <typename E, typename Index, std::size_t N>
+auto DynamicPolicy(const E &e, const Index (&lo)[N], const Index (&hi)[N],
+                   std::int64_t chunk) {
+  using Dynamic = Kokkos::Schedule<Kokkos::Dynamic>;
+  if constexpr (N == 1) {
+    Kokkos::RangePolicy<E, Dynamic, Kokkos::IndexType<Index>> policy(e, lo[0], hi[0]);
+    return policy.set_chunk_size(static_cast<int>(chunk));
+  } else {
+    using Policy = Kokkos::MDRangePolicy<E, Dynamic, Kokkos::Rank<N>>;
+    typename Policy::point_type lower, upper;
+    for (std::size_t d = 0; d < N; ++d) {
+      lower[d] = lo[d];
+      upper[d] = hi[d];
+    }
+    return Policy(e, lower, upper);
+  }
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+} // namespace impl
+} // namespace PortsOfCall
+
+// Scheduled loops: args are the bounds of any rank, start0, stop0,
+// ..., then the functor. A static schedule is the ordinary portableFor.
+template <typename E, typename... Args,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableFor(const char *name, const E &e, const PortsOfCall::Schedule &schedule,
+                 const Args &...args) {
+  if (schedule.kind == PortsOfCall::Schedule::Kind::Static) {
+    portableFor(name, e, args...);
+    return;
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableFor(label, sync, schedule, args...);
+      });
+  if (queued) return;
+#endif
+  constexpr std::size_t nbounds = sizeof...(Args) - 1;
+  const auto all = std::forward_as_tuple(args...);
+  const auto &function = std::get<nbounds>(all);
+  using Index = PortsOfCall::impl::leading_bounds_index_t<nbounds, Args...>;
+  Index lo[nbounds / 2], hi[nbounds / 2];
+  const std::int64_t iterations = [&]<std::size_t... B>(std::index_sequence<B...>) {
+    PortsOfCall::impl::SplitBounds(lo, hi, std::get<B>(all)...);
+    return PortsOfCall::impl::IterationCount(std::get<B>(all)...);
+  }(std::make_index_sequence<nbounds>());
+  const PortsOfCall::impl::KernelTimer timer(name, e, iterations);
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::parallel_for(name, PortsOfCall::impl::DynamicPolicy(e, lo, hi, schedule.chunk),
+                       function);
+#else
+  PortsOfCall::impl::ScheduledFor<E>(schedule, lo, hi, function);
+#endif
+}
+
+template <typename... Tail>
+void portableFor(const char *name, const PortsOfCall::Schedule &schedule,
+                 Tail &&...tail) {
+  portableFor(name, PortsOfCall::Exec::Device(), schedule, std::forward<Tail>(tail)...);
+}
+
+// Scheduled reductions: args are the bounds, the functor, then either
+// a bare T & or reducer objects, as for portableReduce.
+template <typename E, typename... Args,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableReduce(const char *name, const E &e, const PortsOfCall::Schedule &schedule,
+                    Args &&...args) {
+  if (schedule.kind == PortsOfCall::Schedule::Kind::Static) {
+    portableReduce(name, e, std::forward<Args>(args)...);
+    return;
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  using ArgTypes = std::tuple<std::decay_t<Args>...>;
+  constexpr std::size_t nbounds = PortsOfCall::impl::LeadingBounds<Args...>();
+  using Index = PortsOfCall::impl::leading_bounds_index_t<nbounds, Args...>;
+  constexpr std::size_t nreductions = sizeof...(Args) - nbounds - 1;
+  const auto all = std::forward_as_tuple(args...);
+  const auto &function = std::get<nbounds>(all);
+  Index lo[nbounds / 2], hi[nbounds / 2];
+  const std::int64_t iterations = [&]<std::size_t... B>(std::index_sequence<B...>) {
+    PortsOfCall::impl::SplitBounds(lo, hi, std::get<B>(all)...);
+    return PortsOfCall::impl::IterationCount(std::get<B>(all)...);
+  }(std::make_index_sequence<nbounds>());
+  const PortsOfCall::impl::KernelTimer timer(name, e, iterations);
+  [&]<std::size_t... R>(std::index_sequence<R...>) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    const auto policy = PortsOfCall::impl::DynamicPolicy(e, lo, hi, schedule.chunk);
+    if constexpr (PortsOfCall::are_reducers_v<
+                      std::tuple_element_t<nbounds + 1 + R, ArgTypes>...>) {
+      PortsOfCall::impl::KokkosReduce(name, policy, function,
+                                      std::get<nbounds + 1 + R>(all)...);
+    } else {
+      Kokkos::parallel_reduce(name, policy, function, std::get<nbounds + 1 + R>(all)...);
+    }
+#else
+    if constexpr (PortsOfCall::are_reducers_v<
+                      std::tuple_element_t<nbounds + 1 + R, ArgTypes>...>) {
+      const auto result = PortsOfCall::impl::ScheduledReduce<E>(
+          schedule, lo, hi, function, std::get<nbounds + 1 + R>(all)...);
+      ((std::get<nbounds + 1 + R>(all).reference() = std::get<R>(result)), ...);
+      (PortsOfCall::impl::Finalize(std::get<nbounds + 1 + R>(all)), ...);
+    } else {
+      static_assert(nreductions == 1, "Reduce into one bare value or into reducers");
+      auto &reduced = std::get<nbounds + 1>(all);
+      using T = std::decay_t<decltype(reduced)>;
+      reduced += std::get<0>(PortsOfCall::impl::ScheduledReduce<E>(
+          schedule, lo, hi, function, PortsOfCall::impl::Accumulator<T>()));
+    }
+#endif
+  }(std::make_index_sequence<nreductions>());
+}
+
+template <typename... Tail>
+void portableReduce(const char *name, const PortsOfCall::Schedule &schedule,
+                    Tail &&...tail) {
+  portableReduce(name, PortsOfCall::Exec::Device(), schedule,
+                 std::forward<Tail>(tail)...);
+}
+
+// Deterministic reductions: args are the bounds of any rank, the
+// functor, then one bare T & (a sum) or one reducer object
+template <typename E, typename... Args,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableReduce(const char *name, const E &e, const PortsOfCall::Deterministic &mode,
+                    Args &&...args) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  constexpr std::size_t nbounds = PortsOfCall::impl::LeadingBounds<Args...>();
+  using Index = PortsOfCall::impl::leading_bounds_index_t<nbounds, Args...>;
+  static_assert(sizeof...(Args) == nbounds + 2,
+                "Deterministic reductions take one bare value or one reducer");
+  using Reduced = std::decay_t<std::tuple_element_t<nbounds + 1, std::tuple<Args...>>>;
+  const auto all = std::forward_as_tuple(args...);
+  const auto &function = std::get<nbounds>(all);
+  auto &reduced = std::get<nbounds + 1>(all);
+  Index lo[nbounds / 2], hi[nbounds / 2];
+  const std::int64_t iterations = [&]<std::size_t... B>(std::index_sequence<B...>) {
+    PortsOfCall::impl::SplitBounds(lo, hi, std::get<B>(all)...);
+    return PortsOfCall::impl::IterationCount(std::get<B>(all)...);
+  }(std::make_index_sequence<nbounds>());
+  const PortsOfCall::impl::KernelTimer timer(name, e, iterations);
+  if constexpr (PortsOfCall::is_reducer_v<Reduced>) {
+    reduced.reference() = PortsOfCall::impl::DeterministicReduce(name, e, lo, hi,
+                                                                 mode.chunk, function,
+                                                                 reduced);
+    PortsOfCall::impl::Finalize(reduced);
+  } else {
+    const auto sum = PortsOfCall::impl::DeterministicReduce(
+        name, e, lo, hi, mode.chunk, function, PortsOfCall::impl::Accumulator<Reduced>());
+    // as in the other reductions into a bare T, Kokkos overwrites it
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    reduced = sum;
+#else
+    reduced += sum;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  }
+}
+
+template <typename... Tail>
+void portableReduce(const char *name, const PortsOfCall::Deterministic &mode,
+                    Tail &&...tail) {
+  portableReduce(name, PortsOfCall::Exec::Device(), mode, std::forward<Tail>(tail)...);
+}
+
+// Parallel prefix scan over [start, stop). function(i, partial, final)
+// adds element i's contribution to partial; when final is true,
+// partial holds the exact prefix and may be written out. Writing it
+// out before adding gives an exclusive scan, after adding an inclusive
+// one. total receives the sum over the whole range.
+template <typename E, typename Index, typename Function, typename T,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::is_loop_index_v<Index>>>
+void portableScan([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                  Index start, Index stop, const Function &function, T &total) {
+  if constexpr (!std::is_same_v<Index, int>) {
+    if (PortsOfCall::impl::FitsInInt(start, stop)) {
+      portableScan(name, e, static_cast<int>(start), static_cast<int>(stop), function,
+                   total);
+      return;
+    }
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  PortsOfCall::impl::SyncStream(e);
+#endif
+  const PortsOfCall::impl::KernelTimer timer(
+      name, e, PortsOfCall::impl::IterationCount(start, stop));
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy = Kokkos::RangePolicy<E, Kokkos::IndexType<Index>>;
+  Kokkos::parallel_scan(name, Policy(e, start, stop), function, total);
+#else
+  PortsOfCall::impl::Scan<E>(start, stop, function, total);
+#endif
+}
+
+template <typename E, typename Start, typename Stop, typename Function, typename T,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E> &&
+                                      PortsOfCall::impl::needs_loop_index_v<Start, Stop>>>
+void portableScan(const char *name, const E &e, Start start, Stop stop,
+                  const Function &function, T &total) {
+  PortsOfCall::impl::WithLoopIndex(start, stop, [&](auto lo, auto hi) {
+    portableScan(name, e, lo, hi, function, total);
+  });
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableScan([[maybe_unused]] const char *name, Head &&h, Tail &&...tail) {
+  portableScan(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
+}
+
+// Convenience scans of value(i) into out[i]. The exclusive scan reads
+// value(i) before writing out[i], so it may be done in place, e.g.,
+// turning per-item counts into offsets.
+template <typename E, typename Start, typename Stop, typename Value, typename T,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableExclusiveScan(const char *name, const E &e, Start start, Stop stop,
+                           const Value &value, T *out, T &total) {
+  using Index = PortsOfCall::impl::loop_index_t<Start, Stop>;
+  portableScan(
+      name, e, start, stop,
+      PORTABLE_LAMBDA(const Index i, T &partial, const bool final) {
+        const T v = value(i);
+        if (final) out[i] = partial;
+        partial += v;
+      },
+      total);
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableExclusiveScan(const char *name, Head &&h, Tail &&...tail) {
+  portableExclusiveScan(name, PortsOfCall::Exec::Device(), h,
+                        std::forward<Tail>(tail)...);
+}
+
+template <typename E, typename Start, typename Stop, typename Value, typename T,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableInclusiveScan(const char *name, const E &e, Start start, Stop stop,
+                           const Value &value, T *out, T &total) {
+  using Index = PortsOfCall::impl::loop_index_t<Start, Stop>;
+  portableScan(
+      name, e, start, stop,
+      PORTABLE_LAMBDA(const Index i, T &partial, const bool final) {
+        partial += value(i);
+        if (final) out[i] = partial;
+      },
+      total);
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableInclusiveScan(const char *name, Head &&h, Tail &&...tail) {
+  portableInclusiveScan(name, PortsOfCall::Exec::Device(), h,
+                        std::forward<Tail>(tail)...);
+}
+
+// Loops over a list of indices, such as the active zones found by
+// portableSelectIndices, calling function(indices[k]) for k in [0, n).
+// A prefetch functor, if given, is called with the index distance
+// iterations ahead, so the data the loop is about to gather can be
+// requested early with PortsOfCall::Prefetch.
+template <typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableForIndices(const char *name, const E &e, const int *indices, int n,
+                        const Function &function) {
+  portableFor(name, e, 0, n,
+              PortsOfCall::impl::GatherFunction<Function>{indices, n, 0, function, {}});
+}
+
+template <typename E, typename Function, typename Prefetch,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableForIndices(const char *name, const E &e, const int *indices, int n,
+                        const Function &function, const Prefetch &prefetch,
+                        int distance = 16) {
+  portableFor(name, e, 0, n,
+              PortsOfCall::impl::GatherFunction<Function, Prefetch>{indices, n, distance,
+                                                                    function, prefetch});
+}
+
+template <typename... Tail>
+void portableForIndices(const char *name, const int *indices, Tail &&...tail) {
+  portableForIndices(name, PortsOfCall::Exec::Device(), indices,
+                     std::forward<Tail>(tail)...);
+}
+
+// Writes every i in [start, stop) for which predicate(i) is true to
+// indices, in increasing order, and returns how many there were.
+// indices needs room for all of them. This is a parallel scan, so it
+// is blocking, and on host backends the predicate is evaluated twice.
+template <typename E, typename Predicate,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+int portableSelectIndices(const char *name, const E &e, int start, int stop,
+                          const Predicate &predicate, int *indices) {
+  int count = 0;
+  portableScan(
+      name, e, start, stop,
+      PORTABLE_LAMBDA(const int i, int &partial, const bool final) {
+        if (predicate(i)) {
+          if (final) indices[partial] = i;
+          partial++;
+        }
+      },
+      count);
+  return count;
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+int portableSelectIndices(const char *name, Head &&h, Tail &&...tail) {
+  return portableSelectIndices(name, PortsOfCall::Exec::Device(), h,
+                               std::forward<Tail>(tail)...);
+}
+
+// Sorts indices[0, n) in place, so that a gathered loop over a list
+// built some other way walks memory in order. Ordered with the other
+// work on e.
+template <typename E>
+void portableSortIndices(const E &e, int *indices, int n) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::View<int *, typename E::memory_space, Kokkos::MemoryUnmanaged> view(indices, n);
+  Kokkos::sort(e, view);
+#else
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, "portableSortIndices", [=](const char * /*label*/, const auto &sync) {
+        portableSortIndices(sync, indices, n);
+      });
+  if (!queued) std::sort(indices, indices + n);
+#endif
+}
+
+inline void portableSortIndices(int *indices, int n) {
+  portableSortIndices(PortsOfCall::Exec::Device(), indices, n);
+}
+
+// Launch league_size teams, each with scratch_bytes of team scratch
+// memory, calling function(member) once per team. See
+// ports-of-call/portability/team.hpp for the nested ranges.
+template <typename E, typename Function,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableTeamFor([[maybe_unused]] const char *name, [[maybe_unused]] const E &e,
+                     int league_size, std::size_t scratch_bytes,
+                     const Function &function) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableTeamFor(label, sync, league_size, scratch_bytes, function);
+      });
+  if (queued) return;
+#endif
+  const PortsOfCall::impl::KernelTimer timer(name, e, league_size);
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using Policy = Kokkos::TeamPolicy<E>;
+  Policy policy(e, league_size, Kokkos::AUTO, Kokkos::AUTO);
+  if (scratch_bytes > 0) policy.set_scratch_size(0, Kokkos::PerTeam(scratch_bytes));
+  Kokkos::parallel_for(name, policy, function);
+#else
+  PortsOfCall::impl::TeamFor<E>(league_size, scratch_bytes, function);
+#endif
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableTeamFor([[maybe_unused]] const char *name, Head &&h, Tail &&...tail) {
+  portableTeamFor(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
+}
+
+#include <ports-of-call/portability/graph.hpp>
+#include <ports-of-call/portability/autotune.hpp>
+#include <ports-of-call/portability/async_copy.hpp>
+
 #endif // PORTABILITY_HPP
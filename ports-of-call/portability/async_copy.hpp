@@ -0,0 +1,377 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_ASYNC_COPY_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_ASYNC_COPY_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Asynchronous host-device copies in chunks. portableCopyToDeviceAsync
+// and portableCopyToHostAsync return at once with a CopyHandle, and
+// each chunk can be used as soon as it has arrived:
+//
+//   auto copy = portableCopyToDeviceAsync(d, h, n * sizeof(Real));
+//   copy.ForEachChunk([&](std::int64_t lo, std::int64_t hi) {
+//     portableFor("scale", lo, hi, PORTABLE_LAMBDA(std::int64_t i) { d[i] *= 2; });
+//   });
+//
+// A device copy, which needs the Kokkos strategy, runs on a thread of
+// its own. The thread stages each chunk through one of a few pinned
+// host buffers and transfers it on that buffer's stream, so staging a
+// chunk overlaps the transfer of the previous ones. Pinned buffers
+// are kept in a memory pool and reused by later copies. When execution
+// is on the host, a copy is a chunked memcpy over several threads
+// instead.
+//
+// Included at the end of portability.hpp. The source and destination
+// must stay valid until the copy is done; destroying the handle waits
+// for it.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace PortsOfCall {
+
+struct AsyncCopyOptions {
+  // bytes per chunk, the unit of arrival
+  std::size_t chunk_bytes = std::size_t(8) << 20;
+  // threads for a copy on the host, 0 for the host concurrency
+  int nthreads = 0;
+  // pinned buffers a device copy stages through
+  int staging_buffers = 2;
+};
+
+namespace impl {
+enum class CopyDirection { ToDevice, ToHost };
+
+// Which chunks of a copy have arrived, and in what order
+class AsyncCopyState {
+ public:
+  explicit AsyncCopyState(std::size_t nchunks) : arrived_(nchunks, false) {}
+  ~AsyncCopyState() {
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  AsyncCopyState(const AsyncCopyState &) = delete;
+  AsyncCopyState &operator=(const AsyncCopyState &) = delete;
+
+  std::size_t NumChunks() const { return arrived_.size(); }
+
+  void Arrive(std::size_t c) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      arrived_[c] = true;
+      order_.push_back(c);
+    }
+    changed_.notify_all();
+  }
+  void Fail(std::exception_ptr error) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = error;
+    }
+    changed_.notify_all();
+  }
+
+  bool Arrived(std::size_t c) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arrived_[c];
+  }
+  std::size_t NumArrived() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return order_.size();
+  }
+  // Block until chunk c has arrived. If the copy failed, its error is
+  // rethrown instead.
+  void Wait(std::size_t c) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&]() { return arrived_[c] || error_; });
+    if (error_) std::rethrow_exception(error_);
+  }
+  // Block until n + 1 chunks have arrived, and return the last of them
+  std::size_t WaitNth(std::size_t n) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&]() { return order_.size() > n || error_; });
+    if (error_) std::rethrow_exception(error_);
+    return order_[n];
+  }
+
+  // the threads doing the copy, joined on destruction
+  std::vector<std::thread> threads;
+  // next chunk to copy, for copies on the host
+  std::atomic<std::size_t> next{0};
+
+ private:
+  mutable std::mutex mutex_;
+  mutable std::condition_variable changed_;
+  std::vector<bool> arrived_;
+  std::vector<std::size_t> order_;
+  std::exception_ptr error_ = nullptr;
+};
+
+inline int AsyncCopyThreads(int nthreads) {
+  if (nthreads > 0) return nthreads;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  return Kokkos::DefaultHostExecutionSpace().concurrency();
+#elif defined(PORTABILITY_STRATEGY_CUDA)
+  return 1;
+#else
+  return HostConcurrency<Exec::HostParallel>();
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+// Copies chunks on nthreads threads, each taking the next chunk not
+// yet taken
+template <typename T>
+void HostChunkedCopy(AsyncCopyState *state, T *const to, const T *const from,
+                     const std::int64_t length, const std::int64_t chunk,
+                     const int nthreads) {
+  const std::size_t nchunks = state->NumChunks();
+  const std::size_t nworkers = std::min<std::size_t>(nthreads, nchunks);
+  for (std::size_t t = 0; t < nworkers; t++) {
+    state->threads.emplace_back([=]() {
+      try {
+        std::size_t c;
+        while ((c = state->next.fetch_add(1, std::memory_order_relaxed)) < nchunks) {
+          const std::int64_t lo = c * chunk;
+          const std::int64_t hi = std::min(lo + chunk, length);
+          if (to != from) std::copy(from + lo, from + hi, to + lo);
+          state->Arrive(c);
+        }
+      } catch (...) {
+        state->Fail(std::current_exception());
+      }
+    });
+  }
+}
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+using PinnedSpace = Kokkos::SharedHostPinnedSpace;
+#else
+using PinnedSpace = Kokkos::HostSpace;
+#endif // KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+inline void *PinnedMalloc(std::size_t size_bytes) {
+  return Kokkos::kokkos_malloc<PinnedSpace>(size_bytes);
+}
+inline void PinnedFree(void *p) { Kokkos::kokkos_free<PinnedSpace>(p); }
+
+// Staging buffers, cached without limit so that every copy after the
+// first reuses them
+inline MemoryPool &PinnedPool() {
+  static MemoryPool *pool = []() {
+    static MemoryPool instance(&PinnedMalloc, &PinnedFree);
+    instance.SetCapacity(std::numeric_limits<std::size_t>::max());
+    Kokkos::push_finalize_hook([]() { instance.Trim(); });
+    return &instance;
+  }();
+  return *pool;
+}
+
+// One stream per staging buffer, so that transfers from different
+// buffers may overlap
+class StagingStreams {
+ public:
+  explicit StagingStreams(int n)
+      : instances_(Kokkos::Experimental::partition_space(Kokkos::DefaultExecutionSpace(),
+                                                         std::vector<int>(n, 1))) {}
+
+  void Start(int s, CopyDirection direction, void *device, void *pinned,
+             std::size_t size_bytes) {
+    using UM = Kokkos::MemoryUnmanaged;
+    Kokkos::View<char *, Kokkos::DefaultExecutionSpace::memory_space, UM> device_v(
+        static_cast<char *>(device), size_bytes);
+    Kokkos::View<char *, PinnedSpace, UM> pinned_v(static_cast<char *>(pinned),
+                                                   size_bytes);
+    if (direction == CopyDirection::ToDevice) {
+      Kokkos::deep_copy(instances_[s], device_v, pinned_v);
+    } else {
+      Kokkos::deep_copy(instances_[s], pinned_v, device_v);
+    }
+  }
+  void Wait(int s) { instances_[s].fence("PortsOfCall::AsyncCopy"); }
+
+ private:
+  std::vector<Kokkos::DefaultExecutionSpace> instances_;
+};
+
+// Chunk c is staged in buffer c % nstaging, once the chunk that used
+// the buffer before has been transferred
+template <typename T>
+void StagedCopy(AsyncCopyState *state, const CopyDirection direction, T *const to,
+                const T *const from, const std::int64_t length, const std::int64_t chunk,
+                const int nstaging_requested) {
+  const std::size_t nchunks = state->NumChunks();
+  const int nstaging =
+      std::max(1, static_cast<int>(std::min<std::size_t>(nstaging_requested, nchunks)));
+  const std::size_t staging_bytes = chunk * sizeof(T);
+  std::vector<char *> staging(nstaging);
+  for (auto &buffer : staging) {
+    buffer = static_cast<char *>(PinnedPool().Allocate(staging_bytes));
+    PORTABLE_ALWAYS_REQUIRE(buffer != nullptr,
+                            "Could not allocate a pinned staging buffer");
+  }
+  StagingStreams streams(nstaging);
+  state->threads.emplace_back([=, streams = std::move(streams)]() mutable {
+    const auto bounds = [&](std::size_t c) {
+      const std::int64_t lo = c * chunk;
+      return std::make_pair(lo, std::min(lo + chunk, length));
+    };
+    const auto finish = [&](std::size_t c) {
+      const int s = c % nstaging;
+      streams.Wait(s);
+      if (direction == CopyDirection::ToHost) {
+        const auto [lo, hi] = bounds(c);
+        std::memcpy(to + lo, staging[s], (hi - lo) * sizeof(T));
+      }
+      state->Arrive(c);
+    };
+    try {
+      for (std::size_t c = 0; c < nchunks; c++) {
+        const int s = c % nstaging;
+        if (c >= static_cast<std::size_t>(nstaging)) finish(c - nstaging);
+        const auto [lo, hi] = bounds(c);
+        const std::size_t size_bytes = (hi - lo) * sizeof(T);
+        if (direction == CopyDirection::ToDevice) {
+          std::memcpy(staging[s], from + lo, size_bytes);
+          streams.Start(s, direction, to + lo, staging[s], size_bytes);
+        } else {
+          streams.Start(s, direction, const_cast<T *>(from) + lo, staging[s], size_bytes);
+        }
+      }
+      for (std::size_t c = nchunks - std::min<std::size_t>(nstaging, nchunks);
+           c < nchunks; c++) {
+        finish(c);
+      }
+    } catch (...) {
+      state->Fail(std::current_exception());
+    }
+    for (int s = 0; s < nstaging; s++) {
+      streams.Wait(s);
+      PinnedPool().Free(staging[s]);
+    }
+  });
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+} // namespace impl
+
+// An asynchronous copy of length elements in chunks of chunk elements.
+// Chunk c holds elements [ChunkBegin(c), ChunkEnd(c)).
+template <typename T>
+class CopyHandle {
+ public:
+  CopyHandle() = default;
+  CopyHandle(std::unique_ptr<impl::AsyncCopyState> state, std::int64_t length,
+             std::int64_t chunk)
+      : state_(std::move(state)), length_(length), chunk_(chunk) {}
+
+  std::int64_t Size() const { return length_; }
+  std::size_t NumChunks() const { return state_ ? state_->NumChunks() : 0; }
+  std::int64_t ChunkBegin(std::size_t c) const { return c * chunk_; }
+  std::int64_t ChunkEnd(std::size_t c) const {
+    return std::min<std::int64_t>((c + 1) * chunk_, length_);
+  }
+
+  bool Arrived(std::size_t c) const {
+    CheckChunk(c);
+    return state_->Arrived(c);
+  }
+  bool Done() const { return !state_ || state_->NumArrived() == NumChunks(); }
+  void Wait(std::size_t c) const {
+    CheckChunk(c);
+    state_->Wait(c);
+  }
+  void Wait() const {
+    if (NumChunks() > 0) state_->WaitNth(NumChunks() - 1);
+  }
+
+  // Calls function(begin, end) on the calling thread for every chunk,
+  // in the order the chunks arrive, each as soon as it has
+  template <typename Function>
+  void ForEachChunk(const Function &function) const {
+    for (std::size_t n = 0; n < NumChunks(); n++) {
+      const std::size_t c = state_->WaitNth(n);
+      function(ChunkBegin(c), ChunkEnd(c));
+    }
+  }
+
+ private:
+  void CheckChunk(std::size_t c) const {
+    PORTABLE_ALWAYS_REQUIRE(state_ != nullptr, "CopyHandle has no copy in flight");
+    PORTABLE_ALWAYS_REQUIRE(c < NumChunks(), "CopyHandle chunk out of range");
+  }
+
+  std::unique_ptr<impl::AsyncCopyState> state_;
+  std::int64_t length_ = 0;
+  std::int64_t chunk_ = 0;
+};
+
+namespace impl {
+template <typename T>
+CopyHandle<T> StartAsyncCopy([[maybe_unused]] const CopyDirection direction,
+                             T *const to, const T *const from,
+                             const std::size_t size_bytes,
+                             const AsyncCopyOptions &options) {
+  const std::int64_t length = size_bytes / sizeof(T);
+  const std::int64_t chunk =
+      std::max<std::int64_t>(1, options.chunk_bytes / sizeof(T));
+  auto state = std::make_unique<AsyncCopyState>((length + chunk - 1) / chunk);
+  if (length > 0) {
+    if constexpr (EXECUTION_IS_HOST) {
+      HostChunkedCopy(state.get(), to, from, length, chunk,
+                      AsyncCopyThreads(options.nthreads));
+    } else {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+      StagedCopy(state.get(), direction, to, from, length, chunk,
+                 options.staging_buffers);
+#else
+      PORTABLE_ALWAYS_ABORT("Asynchronous device copies require the Kokkos strategy");
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    }
+  }
+  return CopyHandle<T>(std::move(state), length, chunk);
+}
+} // namespace impl
+} // namespace PortsOfCall
+
+template <typename T>
+PortsOfCall::CopyHandle<T>
+portableCopyToDeviceAsync(T *const to, T const *const from, size_t const size_bytes,
+                          const PortsOfCall::AsyncCopyOptions &options = {}) {
+  return PortsOfCall::impl::StartAsyncCopy(PortsOfCall::impl::CopyDirection::ToDevice,
+                                           to, from, size_bytes, options);
+}
+
+template <typename T>
+PortsOfCall::CopyHandle<T>
+portableCopyToHostAsync(T *const to, T const *const from, size_t const size_bytes,
+                        const PortsOfCall::AsyncCopyOptions &options = {}) {
+  return PortsOfCall::impl::StartAsyncCopy(PortsOfCall::impl::CopyDirection::ToHost,
+                                           to, from, size_bytes, options);
+}
+
+#endif // _PORTS_OF_CALL_PORTABILITY_ASYNC_COPY_HPP_
@@ -0,0 +1,413 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_AUTOTUNE_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_AUTOTUNE_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Opt-in autotuning of portableForTuned launches. While tuning a
+// kernel, each launch runs the next candidate configuration (tile
+// sizes, schedule and, on host backends, thread count) and is timed;
+// once every candidate has been tried a few times the fastest is kept
+// for all later launches. Kernels are told apart by name and by the
+// size class of their index space (the power of two below the number
+// of iterations), so one kernel may be tuned separately for small and
+// large problems.
+//
+// Tuned configurations are saved to a cache file, keyed by host, size
+// class and kernel name, and loaded on the next run so that it starts
+// tuned. Autotuning is off unless enabled with Autotune::Enable() or
+// the environment:
+//
+//   PORTS_OF_CALL_AUTOTUNE=1               enable autotuning
+//   PORTS_OF_CALL_AUTOTUNE_CACHE=<path>    cache file, by default
+//                                          ports-of-call-autotune.txt
+//
+// When disabled, portableForTuned is portableFor.
+//
+// Included at the end of portability.hpp.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace PortsOfCall {
+namespace Autotune {
+
+// One way of running a loop. A non-empty tile is handed to portableFor
+// as TileSizes (zeros being automatic), otherwise the schedule is used.
+// threads = 0 means all threads.
+struct Config {
+  Schedule schedule;
+  std::vector<int> tile;
+  int threads = 0;
+
+  // kind chunk threads tile, e.g. "dynamic 64 8 -" or "static 1 0 0,64"
+  std::string ToString() const {
+    static const char *kinds[] = {"static", "dynamic", "guided"};
+    std::ostringstream os;
+    os << kinds[static_cast<int>(schedule.kind)] << " " << schedule.chunk << " "
+       << threads << " ";
+    if (tile.empty()) os << "-";
+    for (std::size_t d = 0; d < tile.size(); ++d) {
+      os << (d > 0 ? "," : "") << tile[d];
+    }
+    return os.str();
+  }
+
+  static std::optional<Config> Parse(const std::string &text) {
+    std::istringstream is(text);
+    std::string kind, tiles;
+    Config config;
+    if (!(is >> kind >> config.schedule.chunk >> config.threads >> tiles)) {
+      return std::nullopt;
+    }
+    if (kind == "static") {
+      config.schedule.kind = Schedule::Kind::Static;
+    } else if (kind == "dynamic") {
+      config.schedule.kind = Schedule::Kind::Dynamic;
+    } else if (kind == "guided") {
+      config.schedule.kind = Schedule::Kind::Guided;
+    } else {
+      return std::nullopt;
+    }
+    if (tiles != "-") {
+      std::istringstream ts(tiles);
+      std::string t;
+      while (std::getline(ts, t, ',')) {
+        config.tile.push_back(std::atoi(t.c_str()));
+      }
+    }
+    return config;
+  }
+};
+
+} // namespace Autotune
+
+namespace impl {
+class AutotuneRegistry {
+ public:
+  // Timed launches per candidate; the fastest of them counts
+  static constexpr int samples = 2;
+
+  static AutotuneRegistry &Get() {
+    static AutotuneRegistry registry;
+    return registry;
+  }
+
+  bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void Enable(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+  std::string CacheFile() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_file_;
+  }
+  void SetCacheFile(std::string path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_file_ = std::move(path);
+    loaded_ = false;
+  }
+  // Forget all tuning in memory; the cache file is read again on next use
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    kernels_.clear();
+    loaded_ = false;
+  }
+
+  static int SizeClass(std::int64_t iterations) {
+    int size_class = 0;
+    while (iterations > 1) {
+      iterations >>= 1;
+      size_class++;
+    }
+    return size_class;
+  }
+
+  // The configuration for the next launch of a kernel, and for a timed
+  // trial the index of the candidate to pass to Record, otherwise -1.
+  // Candidates are generated on first sight of a kernel that is not in
+  // the cache. Concurrent launches are handed successive trials.
+  template <typename MakeCandidates>
+  std::pair<Autotune::Config, int> Next(const std::string &name, std::int64_t iterations,
+                                        const MakeCandidates &make_candidates) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Load();
+    Kernel &kernel = kernels_[MakeKey(name, SizeClass(iterations))];
+    if (kernel.tuned) return {kernel.best, -1};
+    if (kernel.candidates.empty()) {
+      kernel.candidates = make_candidates();
+      kernel.seconds.assign(kernel.candidates.size(), -1);
+    }
+    const int ncandidates = static_cast<int>(kernel.candidates.size());
+    const int candidate = (kernel.issued++ / samples) % ncandidates;
+    return {kernel.candidates[candidate], candidate};
+  }
+
+  // Record the time of a trial of the candidate returned by Next. After
+  // the last trial the fastest candidate is chosen and the cache file
+  // rewritten.
+  void Record(const std::string &name, std::int64_t iterations, int candidate,
+              double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Kernel &kernel = kernels_[MakeKey(name, SizeClass(iterations))];
+    if (kernel.tuned || kernel.candidates.empty()) return;
+    double &best = kernel.seconds[candidate];
+    if (best < 0 || seconds < best) best = seconds;
+    if (++kernel.trial < samples * static_cast<int>(kernel.candidates.size())) return;
+    // a candidate whose trials are still running is not chosen
+    std::size_t fastest = candidate;
+    for (std::size_t c = 0; c < kernel.candidates.size(); ++c) {
+      const double t = kernel.seconds[c];
+      if (t >= 0 && t < kernel.seconds[fastest]) fastest = c;
+    }
+    kernel.best = kernel.candidates[fastest];
+    kernel.tuned = true;
+    Save();
+  }
+
+  std::optional<Autotune::Config> Chosen(const std::string &name,
+                                         std::int64_t iterations) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Load();
+    const auto it = kernels_.find(MakeKey(name, SizeClass(iterations)));
+    if (it == kernels_.end() || !it->second.tuned) return std::nullopt;
+    return it->second.best;
+  }
+
+ private:
+  struct Kernel {
+    bool tuned = false;
+    Autotune::Config best;
+    std::vector<Autotune::Config> candidates;
+    std::vector<double> seconds;
+    // trials handed out by Next, and those recorded
+    int issued = 0;
+    int trial = 0;
+  };
+  // host, size class and name, in the order of the cache file's fields
+  using Key = std::tuple<std::string, int, std::string>;
+
+  AutotuneRegistry() {
+    if (const char *env = std::getenv("PORTS_OF_CALL_AUTOTUNE")) {
+      const std::string mode(env);
+      enabled_ = !mode.empty() && mode != "0";
+    }
+    if (const char *env = std::getenv("PORTS_OF_CALL_AUTOTUNE_CACHE")) {
+      cache_file_ = env;
+    }
+    host_ = HostName();
+  }
+
+  static std::string HostName() {
+#if __has_include(<unistd.h>)
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0') return name;
+#endif
+    const char *env = std::getenv("HOSTNAME");
+    return env ? env : "localhost";
+  }
+
+  static std::string ProcessId() {
+#if __has_include(<unistd.h>)
+    return std::to_string(getpid());
+#else
+    return std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+  }
+
+  Key MakeKey(const std::string &name, int size_class) const {
+    return {host_, size_class, name};
+  }
+
+  // Cache lines are host, size class, configuration and kernel name,
+  // separated by tabs. Entries for other hosts are kept when saving.
+  void Load() {
+    if (loaded_) return;
+    loaded_ = true;
+    std::ifstream file(cache_file_);
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream is(line);
+      std::string host, size_class, config, name;
+      if (!std::getline(is, host, '\t') || !std::getline(is, size_class, '\t') ||
+          !std::getline(is, config, '\t') || !std::getline(is, name)) {
+        continue;
+      }
+      const auto parsed = Autotune::Config::Parse(config);
+      if (!parsed) continue;
+      Kernel &kernel = kernels_[{host, std::atoi(size_class.c_str()), name}];
+      kernel.tuned = true;
+      kernel.best = *parsed;
+    }
+  }
+
+  // Written to a temporary file and renamed, so a concurrent reader
+  // never sees half a file. The temporary is named per process, since
+  // e.g. MPI ranks may share a working directory and a cache file.
+  void Save() const {
+    const std::string tmp = cache_file_ + "." + ProcessId() + ".tmp";
+    {
+      std::ofstream file(tmp);
+      for (const auto &[key, kernel] : kernels_) {
+        if (!kernel.tuned) continue;
+        file << std::get<0>(key) << '\t' << std::get<1>(key) << '\t'
+             << kernel.best.ToString() << '\t' << std::get<2>(key) << '\n';
+      }
+      if (!file) return;
+    }
+    std::rename(tmp.c_str(), cache_file_.c_str());
+  }
+
+  mutable std::mutex mutex_;
+  std::atomic<bool> enabled_{false};
+  bool loaded_ = false;
+  std::string cache_file_ = "ports-of-call-autotune.txt";
+  std::string host_;
+  std::map<Key, Kernel> kernels_;
+};
+
+// Candidate configurations for a rank-N loop of n iterations on up to
+// nthreads threads: the static default, automatic tiles (N > 1),
+// dynamic and guided schedules, each also on half the threads.
+template <std::size_t N>
+std::vector<Autotune::Config> AutotuneCandidates(std::int64_t n, int nthreads) {
+  std::vector<Autotune::Config> variants(1);
+  if constexpr (N > 1) {
+    variants.push_back({Schedule::Static(), std::vector<int>(N, 0), 0});
+    std::vector<int> narrow(N, 0);
+    narrow[N - 1] = 64;
+    variants.push_back({Schedule::Static(), narrow, 0});
+  }
+  const std::int64_t per_thread = std::max<std::int64_t>(1, n / std::max(1, nthreads));
+  const std::int64_t coarse = std::max<std::int64_t>(1, per_thread / 8);
+  const std::int64_t fine = std::max<std::int64_t>(1, per_thread / 64);
+  variants.push_back({Schedule::Dynamic(coarse), {}, 0});
+  variants.push_back({Schedule::Dynamic(fine), {}, 0});
+  variants.push_back({Schedule::Guided(fine), {}, 0});
+  std::vector<Autotune::Config> candidates = variants;
+  if (nthreads > 2) {
+    for (auto config : variants) {
+      config.threads = nthreads / 2;
+      candidates.push_back(config);
+    }
+  }
+  return candidates;
+}
+} // namespace impl
+
+namespace Autotune {
+inline void Enable(bool on = true) { impl::AutotuneRegistry::Get().Enable(on); }
+inline bool Enabled() { return impl::AutotuneRegistry::Get().Enabled(); }
+inline void SetCacheFile(const std::string &path) {
+  impl::AutotuneRegistry::Get().SetCacheFile(path);
+}
+inline std::string CacheFile() { return impl::AutotuneRegistry::Get().CacheFile(); }
+// Forget all tuning done in this process
+inline void Reset() { impl::AutotuneRegistry::Get().Reset(); }
+// The configuration chosen for a kernel of this many iterations, if
+// tuning it is finished (or it was in the cache)
+inline std::optional<Config> Chosen(const std::string &name, std::int64_t iterations) {
+  return impl::AutotuneRegistry::Get().Chosen(name, iterations);
+}
+} // namespace Autotune
+
+namespace impl {
+// Runs a loop with bounds then functor in args as config says
+template <typename E, typename... Args>
+void LaunchWithConfig(const char *name, const E &e, const Autotune::Config &config,
+                      const Args &...args) {
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const ScopedConcurrency concurrency(config.threads);
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  constexpr std::size_t rank = (sizeof...(Args) - 1) / 2;
+  if constexpr (rank > 1) {
+    if (config.tile.size() == rank) {
+      TileSizes<rank> tiles;
+      std::copy(config.tile.begin(), config.tile.end(), tiles.extent);
+      portableFor(name, e, tiles, args...);
+      return;
+    }
+  }
+  portableFor(name, e, config.schedule, args...);
+}
+} // namespace impl
+} // namespace PortsOfCall
+
+// portableFor over bounds of any rank, then the functor, with the tile
+// sizes, schedule and thread count chosen by the autotuner. Trials are
+// synchronous, so the launch is timed accurately; once tuned, launches
+// are as asynchronous as those of portableFor.
+template <typename E, typename... Args,
+          typename = std::enable_if_t<!std::is_arithmetic_v<E>>>
+void portableForTuned(const char *name, const E &e, const Args &...args) {
+  auto &registry = PortsOfCall::impl::AutotuneRegistry::Get();
+  if (!registry.Enabled()) {
+    portableFor(name, e, args...);
+    return;
+  }
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  const bool queued = PortsOfCall::impl::LaunchOnStream(
+      e, name, [=](const char *label, const auto &sync) {
+        portableForTuned(label, sync, args...);
+      });
+  if (queued) return;
+#endif
+  constexpr std::size_t rank = (sizeof...(Args) - 1) / 2;
+  const auto all = std::forward_as_tuple(args...);
+  const std::int64_t iterations = [&]<std::size_t... B>(std::index_sequence<B...>) {
+    return PortsOfCall::impl::IterationCount(std::get<B>(all)...);
+  }(std::make_index_sequence<2 * rank>());
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  const int nthreads = 0;
+#else
+  const int nthreads = PortsOfCall::impl::HostConcurrency<E>();
+#endif
+  const auto [config, candidate] = registry.Next(name, iterations, [&]() {
+    return PortsOfCall::impl::AutotuneCandidates<rank>(iterations, nthreads);
+  });
+  if (candidate < 0) {
+    PortsOfCall::impl::LaunchWithConfig(name, e, config, args...);
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  PortsOfCall::impl::LaunchWithConfig(name, e, config, args...);
+  PortsOfCall::impl::Fence(e);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  registry.Record(name, iterations, candidate, elapsed.count());
+}
+
+template <typename Head, typename... Tail,
+          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<Head>>>>
+void portableForTuned(const char *name, Head &&h, Tail &&...tail) {
+  portableForTuned(name, PortsOfCall::Exec::Device(), h, std::forward<Tail>(tail)...);
+}
+
+#endif // _PORTS_OF_CALL_PORTABILITY_AUTOTUNE_HPP_
@@ -0,0 +1,339 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_GRAPH_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_GRAPH_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Record a fixed sequence of loops, reductions and copies once and
+// replay it every cycle. Included at the end of portability.hpp, since
+// graph nodes are ordinary portableFor and portableReduce launches.
+//
+// Under Kokkos, each run of kernels between copies becomes a
+// Kokkos::Experimental::Graph, built with the recorded dependencies.
+// Otherwise the graph is a pre-built task list: a replay on an
+// instance with a stream is a single submission, which runs the whole
+// list in order on the stream's thread, and a replay on a synchronous
+// instance runs it in place.
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+#include <optional>
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+#include <ports-of-call/portable_errors.hpp>
+
+namespace PortsOfCall {
+
+// Handle to a node of a Graph, for naming it as a dependency
+struct GraphNode {
+  std::size_t id;
+};
+
+namespace impl {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+// The Kokkos policy for graph kernels with bounds start0, stop0, ...
+template <typename E, typename... Bounds>
+auto GraphPolicy(const Bounds... bounds) {
+  static_assert((std::is_arithmetic_v<Bounds> && ...),
+                "Graph kernels under Kokkos take plain loop bounds");
+  constexpr std::size_t rank = sizeof...(Bounds) / 2;
+  const std::int64_t b[] = {static_cast<std::int64_t>(bounds)...};
+  if constexpr (rank == 1) {
+    return Kokkos::RangePolicy<E>(b[0], b[1]);
+  } else {
+    Kokkos::Array<std::int64_t, rank> lo, hi;
+    for (std::size_t d = 0; d < rank; ++d) {
+      lo[d] = b[2 * d];
+      hi[d] = b[2 * d + 1];
+    }
+    return Kokkos::MDRangePolicy<E, Kokkos::Rank<rank>>(lo, hi);
+  }
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+// Calls launch(args[I]...) with a subset of a tuple of arguments
+template <std::size_t... I, typename Tuple, typename Launch>
+decltype(auto) ApplySome(std::index_sequence<I...>, const Tuple &args,
+                         const Launch &launch) {
+  return launch(std::get<I>(args)...);
+}
+} // namespace impl
+
+template <typename E = Exec::Device>
+class Graph {
+ public:
+  explicit Graph(const E &e = E()) : e_(e) {}
+
+  // A node runs after the node added just before it, unless it is
+  // given its dependencies explicitly. Nodes may only depend on nodes
+  // added earlier, so insertion order is always a valid order.
+
+  // A portableFor over args: bounds then the functor
+  template <typename... Args>
+  GraphNode AddFor(const char *name, const Args &...args) {
+    return AddKernel(Sequential(), name, args...);
+  }
+  template <typename... Args>
+  GraphNode AddFor(const char *name, std::initializer_list<GraphNode> after,
+                   const Args &...args) {
+    return AddKernel(After(after), name, args...);
+  }
+
+  // A portableReduce over args: bounds, the functor, and last a T *
+  // that receives the sum. Under Kokkos the result must be accessible
+  // from E, e.g. allocated with portableMalloc.
+  template <typename... Args>
+  GraphNode AddReduce(const char *name, const Args &...args) {
+    return AddReduction(Sequential(), name, args...);
+  }
+  template <typename... Args>
+  GraphNode AddReduce(const char *name, std::initializer_list<GraphNode> after,
+                      const Args &...args) {
+    return AddReduction(After(after), name, args...);
+  }
+
+  template <typename T>
+  GraphNode AddCopyToDevice(T *to, const T *from, std::size_t size_bytes) {
+    return AddCopy(Sequential(), CopyToDevice(to, from, size_bytes));
+  }
+  template <typename T>
+  GraphNode AddCopyToDevice(std::initializer_list<GraphNode> after, T *to,
+                            const T *from, std::size_t size_bytes) {
+    return AddCopy(After(after), CopyToDevice(to, from, size_bytes));
+  }
+
+  template <typename T>
+  GraphNode AddCopyToHost(T *to, const T *from, std::size_t size_bytes) {
+    return AddCopy(Sequential(), CopyToHost(to, from, size_bytes));
+  }
+  template <typename T>
+  GraphNode AddCopyToHost(std::initializer_list<GraphNode> after, T *to, const T *from,
+                          std::size_t size_bytes) {
+    return AddCopy(After(after), CopyToHost(to, from, size_bytes));
+  }
+
+  std::size_t Size() const { return nodes_.size(); }
+
+  // Builds the executable form of the graph. Called by the first
+  // Submit after nodes were added; call it directly to keep that cost
+  // out of the first cycle.
+  void Instantiate() {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    steps_.clear();
+    std::size_t first = 0;
+    while (first < nodes_.size()) {
+      if (nodes_[first].copy) {
+        steps_.push_back({std::nullopt, nodes_[first].copy});
+        ++first;
+        continue;
+      }
+      std::size_t last = first;
+      while (last < nodes_.size() && !nodes_[last].copy) {
+        ++last;
+      }
+      steps_.push_back({BuildKernels(first, last), nullptr});
+      first = last;
+    }
+#else
+    auto tasks = std::make_shared<std::vector<std::function<void()>>>();
+    tasks->reserve(nodes_.size());
+    for (const auto &node : nodes_) {
+      tasks->push_back(node.run);
+    }
+    tasks_ = std::move(tasks);
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    instantiated_ = true;
+  }
+
+  // Replays the whole graph on the instance it was created with. Like
+  // the launches it holds, this is asynchronous unless the instance is
+  // synchronous; use PORTABLE_FENCE or Fence() to wait for it.
+  void Submit() {
+    if (!instantiated_) Instantiate();
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    for (auto &step : steps_) {
+      if (step.graph) {
+        step.graph->submit();
+      } else {
+        step.copy(e_);
+      }
+    }
+#else
+    const auto run = [tasks = tasks_]() {
+      for (const auto &task : *tasks) {
+        task();
+      }
+    };
+    if (const auto *stream = impl::StreamOf(e_)) {
+      (*stream)->Enqueue(run);
+    } else {
+      run();
+    }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  }
+
+  void Fence() const { impl::Fence(e_); }
+
+ private:
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using NodeRef = Kokkos::Experimental::GraphNodeRef<E>;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+  struct Node {
+    std::vector<std::size_t> after;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    // appends the kernel to the node it depends on
+    std::function<NodeRef(const NodeRef &)> kernel;
+#else
+    std::function<void()> run;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    // a copy, ordered on the instance but outside the kernel graph
+    std::function<void(const E &)> copy;
+  };
+
+  // A node after the most recent one
+  Node Sequential() const {
+    Node node;
+    if (!nodes_.empty()) node.after.push_back(nodes_.size() - 1);
+    return node;
+  }
+
+  Node After(std::initializer_list<GraphNode> after) const {
+    Node node;
+    for (const auto &dep : after) {
+      PORTABLE_ALWAYS_REQUIRE(dep.id < nodes_.size(),
+                              "Graph nodes may only depend on earlier nodes");
+      node.after.push_back(dep.id);
+    }
+    return node;
+  }
+
+  template <typename... Args>
+  GraphNode AddKernel(Node node, const char *name, const Args &...args) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    const auto bounds = std::make_tuple(args...);
+    constexpr std::size_t nbounds = sizeof...(Args) - 1;
+    node.kernel = [label = std::string(name), bounds](const NodeRef &pred) -> NodeRef {
+      const auto policy = impl::ApplySome(
+          std::make_index_sequence<nbounds>(), bounds,
+          [](const auto &...b) { return impl::GraphPolicy<E>(b...); });
+      return pred.then_parallel_for(label, policy, std::get<nbounds>(bounds));
+    };
+#else
+    node.run = [label = std::string(name), ... args = args]() {
+      portableFor(label.c_str(), E(), args...);
+    };
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    return Add(std::move(node));
+  }
+
+  template <typename... Args>
+  GraphNode AddReduction(Node node, const char *name, const Args &...args) {
+    const auto all = std::make_tuple(args...);
+    constexpr std::size_t nargs = sizeof...(Args) - 1;
+    using ResultPtr = std::tuple_element_t<nargs, std::tuple<Args...>>;
+    static_assert(std::is_pointer_v<ResultPtr>,
+                  "AddReduce takes a pointer to its result");
+    using T = std::remove_pointer_t<ResultPtr>;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    node.kernel = [label = std::string(name), all](const NodeRef &pred) -> NodeRef {
+      const auto policy = impl::ApplySome(
+          std::make_index_sequence<nargs - 1>(), all,
+          [](const auto &...b) { return impl::GraphPolicy<E>(b...); });
+      using Result = Kokkos::View<T, typename E::memory_space, Kokkos::MemoryUnmanaged>;
+      return pred.then_parallel_reduce(label, policy, std::get<nargs - 1>(all),
+                                       Result(std::get<nargs>(all)));
+    };
+#else
+    node.run = [label = std::string(name), all]() {
+      T sum{};
+      impl::ApplySome(std::make_index_sequence<nargs>(), all, [&](const auto &...a) {
+        portableReduce(label.c_str(), E(), a..., sum);
+      });
+      *std::get<nargs>(all) = sum;
+    };
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    return Add(std::move(node));
+  }
+
+  template <typename T>
+  static auto CopyToDevice(T *to, const T *from, std::size_t size_bytes) {
+    return [=](const E &e) { portableCopyToDevice(e, to, from, size_bytes); };
+  }
+  template <typename T>
+  static auto CopyToHost(T *to, const T *from, std::size_t size_bytes) {
+    return [=](const E &e) { portableCopyToHost(e, to, from, size_bytes); };
+  }
+
+  template <typename Copy>
+  GraphNode AddCopy(Node node, const Copy &copy) {
+    node.copy = copy;
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+    node.run = [copy]() { copy(E()); };
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    return Add(std::move(node));
+  }
+
+  GraphNode Add(Node &&node) {
+    nodes_.push_back(std::move(node));
+    instantiated_ = false;
+    return {nodes_.size() - 1};
+  }
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  // A Kokkos graph of the kernels in [first, last). Dependencies on
+  // nodes before first are met by the order of the steps.
+  Kokkos::Experimental::Graph<E> BuildKernels(std::size_t first, std::size_t last) const {
+    return Kokkos::Experimental::create_graph(e_, [&](const auto &root) {
+      std::vector<std::optional<NodeRef>> refs(last - first);
+      for (std::size_t n = first; n < last; ++n) {
+        std::optional<NodeRef> pred;
+        for (const std::size_t dep : nodes_[n].after) {
+          if (dep < first) continue;
+          const NodeRef &ref = *refs[dep - first];
+          pred = pred ? NodeRef(Kokkos::Experimental::when_all(*pred, ref)) : ref;
+        }
+        refs[n - first] = nodes_[n].kernel(pred ? *pred : NodeRef(root));
+      }
+    });
+  }
+
+  struct Step {
+    std::optional<Kokkos::Experimental::Graph<E>> graph;
+    std::function<void(const E &)> copy;
+  };
+  std::vector<Step> steps_;
+#else
+  std::shared_ptr<const std::vector<std::function<void()>>> tasks_;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+  E e_;
+  std::vector<Node> nodes_;
+  bool instantiated_ = false;
+};
+
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_GRAPH_HPP_
@@ -0,0 +1,146 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_HOST_ALLOC_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_HOST_ALLOC_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Host allocations with a given alignment and page size, for the
+// alignment and huge_pages fields of MallocOptions. Such blocks are
+// remembered so that portableFree, which only sees the pointer, can
+// return them to the right allocator.
+//
+// Huge pages are 2 MiB, the x86-64 and aarch64 default. Transparent
+// huge pages are ordinary anonymous memory aligned to 2 MiB and marked
+// with madvise(MADV_HUGEPAGE), which the kernel backs with huge pages
+// when it can. Explicit huge pages come from the reserved hugetlbfs
+// pool (mmap with MAP_HUGETLB); when none are reserved the allocation
+// falls back to transparent huge pages. Without <sys/mman.h> both are
+// 2 MiB-aligned ordinary memory.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+namespace PortsOfCall {
+
+enum class HugePages { None, Transparent, Explicit };
+
+namespace impl {
+class HostAllocator {
+ public:
+  static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+  // size_bytes at a multiple of alignment (0 for malloc's) on pages
+  // as requested, or nullptr
+  static void *Allocate(std::size_t size_bytes, std::size_t alignment,
+                        HugePages pages) {
+    if (size_bytes == 0) size_bytes = 1;
+    if (pages != HugePages::None) alignment = std::max(alignment, huge_page_size);
+    alignment = std::max(alignment, alignof(std::max_align_t));
+    const std::size_t size = RoundUp(size_bytes, alignment);
+    Block block{size, HugePages::None, false};
+    void *p = nullptr;
+#ifdef MAP_HUGETLB
+    if (pages == HugePages::Explicit) {
+      p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p == MAP_FAILED) {
+        p = nullptr;
+      } else {
+        block.pages = HugePages::Explicit;
+        block.mapped = true;
+      }
+    }
+#endif // MAP_HUGETLB
+    if (p == nullptr) {
+      p = std::aligned_alloc(alignment, size);
+      if (p == nullptr) return p;
+#ifdef MADV_HUGEPAGE
+      if (pages != HugePages::None && madvise(p, size, MADV_HUGEPAGE) == 0) {
+        block.pages = HugePages::Transparent;
+      }
+#endif
+    }
+    Registry &registry = Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.blocks.emplace(p, block);
+    registry.count.fetch_add(1, std::memory_order_release);
+    return p;
+  }
+
+  // Frees p if it came from Allocate, returning whether it did
+  static bool Free(void *p) {
+    Registry &registry = Get();
+    if (p == nullptr || registry.count.load(std::memory_order_acquire) == 0) return false;
+    Block block;
+    {
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      const auto it = registry.blocks.find(p);
+      if (it == registry.blocks.end()) return false;
+      block = it->second;
+      registry.blocks.erase(it);
+      registry.count.fetch_sub(1, std::memory_order_release);
+    }
+#ifdef MAP_HUGETLB
+    if (block.mapped) {
+      munmap(p, block.size);
+      return true;
+    }
+#endif // MAP_HUGETLB
+    std::free(p);
+    return true;
+  }
+
+  // The pages p was given: None for ordinary pages, or for memory
+  // that did not come from Allocate
+  static HugePages PagesOf(const void *p) {
+    Registry &registry = Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const auto it = registry.blocks.find(const_cast<void *>(p));
+    return it == registry.blocks.end() ? HugePages::None : it->second.pages;
+  }
+
+ private:
+  struct Block {
+    std::size_t size = 0;
+    HugePages pages = HugePages::None;
+    bool mapped = false;
+  };
+  struct Registry {
+    std::mutex mutex;
+    std::unordered_map<void *, Block> blocks;
+    std::atomic<std::size_t> count{0};
+  };
+  static Registry &Get() {
+    static Registry registry;
+    return registry;
+  }
+  static std::size_t RoundUp(std::size_t n, std::size_t multiple) {
+    return (n + multiple - 1) / multiple * multiple;
+  }
+};
+} // namespace impl
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_HOST_ALLOC_HPP_
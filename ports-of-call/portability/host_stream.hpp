@@ -0,0 +1,199 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_HOST_STREAM_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_HOST_STREAM_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// The host analogue of a device stream. Work submitted to a stream is
+// run in submission order on a dedicated thread, asynchronously with
+// respect to the submitting thread, so work on different streams may
+// overlap. A loop on a parallel execution space still fans out over
+// the thread pool (or OpenMP) from the stream's thread. Every
+// submission is numbered, which lets callers wait for a prefix of the
+// stream; that is what events are built on.
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PortsOfCall {
+namespace impl {
+
+class HostStream {
+ public:
+  // Streams are always shared, and registered so a global fence can
+  // find them.
+  static std::shared_ptr<HostStream> Create() {
+    std::shared_ptr<HostStream> stream(new HostStream());
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::erase_if(registry.streams, [](const auto &s) { return s.expired(); });
+    registry.streams.push_back(stream);
+    return stream;
+  }
+
+  // Drains outstanding work. Errors that nobody waited for are dropped.
+  ~HostStream() {
+    if (std::this_thread::get_id() == thread_.get_id()) {
+      // A task dropped the last reference, so this runs inside Run,
+      // and a thread cannot join itself. Nothing else can reach the
+      // stream now: finish its queue here and let Run return.
+      while (!tasks_.empty()) {
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        try {
+          task();
+        } catch (...) {
+        }
+      }
+      released_ = true;
+      thread_.detach();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_.notify_one();
+    thread_.join();
+  }
+  HostStream(const HostStream &) = delete;
+  HostStream &operator=(const HostStream &) = delete;
+
+  // Queue task and return its ticket, which counts from 1
+  std::uint64_t Enqueue(std::function<void()> task) {
+    std::uint64_t ticket;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+      ticket = ++submitted_;
+    }
+    work_.notify_one();
+    return ticket;
+  }
+
+  // Ticket of the most recent submission
+  std::uint64_t Submitted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return submitted_;
+  }
+
+  bool Done(std::uint64_t ticket) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_ >= ticket;
+  }
+
+  // Block until every task up to and including ticket has run. If a
+  // task threw, the first such exception is rethrown here, once.
+  void Wait(std::uint64_t ticket) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return completed_ >= ticket; });
+    if (error_) {
+      std::exception_ptr error = nullptr;
+      std::swap(error, error_);
+      std::rethrow_exception(error);
+    }
+  }
+
+  // As Wait, but leaves any error for the stream's own waiters. Used
+  // when one stream waits on another.
+  void WaitQuietly(std::uint64_t ticket) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return completed_ >= ticket; });
+  }
+
+  void Fence() { Wait(Submitted()); }
+
+  // Fence every live stream
+  static void FenceAll() {
+    std::vector<std::shared_ptr<HostStream>> live;
+    {
+      Registry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      for (const auto &s : registry.streams) {
+        if (auto stream = s.lock()) live.push_back(std::move(stream));
+      }
+    }
+    for (auto &stream : live) {
+      stream->Fence();
+    }
+  }
+
+ private:
+  struct Registry {
+    std::mutex mutex;
+    std::vector<std::weak_ptr<HostStream>> streams;
+  };
+  static Registry &GetRegistry() {
+    static Registry registry;
+    return registry;
+  }
+
+  HostStream() : thread_([this]() { Run(); }) {}
+
+  void Run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      std::exception_ptr error = nullptr;
+      try {
+        task();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error && !error_) error_ = error;
+        completed_++;
+      }
+      done_.notify_all();
+      // may release the last reference to this stream
+      task = nullptr;
+      if (released_) return;
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_;
+  mutable std::condition_variable done_;
+  std::deque<std::function<void()>> tasks_;
+  std::uint64_t submitted_ = 0;
+  std::uint64_t completed_ = 0;
+  std::exception_ptr error_ = nullptr;
+  bool stop_ = false;
+  // set on the stream's thread once the stream has been destroyed
+  static inline thread_local bool released_ = false;
+  // declared last so the members above exist before Run starts
+  std::thread thread_;
+};
+
+} // namespace impl
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_HOST_STREAM_HPP_
@@ -0,0 +1,248 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_MD_RANGE_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_MD_RANGE_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Host-side machinery for walking a rank-N index space, either whole
+// or tile by tile, and for splitting it across the thread pool. The
+// index space is flattened in lexicographic order (last index fastest,
+// matching the serial loops in portability.hpp) and cut into
+// contiguous blocks, one per thread.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <ports-of-call/portability/thread_pool.hpp>
+
+namespace PortsOfCall {
+namespace impl {
+
+inline std::int64_t IntPow(std::int64_t base, int exp) {
+  std::int64_t result = 1;
+  for (int i = 0; i < exp; ++i) {
+    result *= base;
+  }
+  return result;
+}
+
+// Index is int, or std::int64_t for 1D loops whose bounds need it
+template <std::size_t N, typename Index = int>
+struct MDRange {
+  Index lo[N];
+  Index hi[N];
+
+  std::int64_t Size() const {
+    std::int64_t n = 1;
+    for (std::size_t d = 0; d < N; ++d) {
+      if (hi[d] <= lo[d]) return 0;
+      n *= static_cast<std::int64_t>(hi[d] - lo[d]);
+    }
+    return n;
+  }
+};
+
+template <typename Function, typename Index, std::size_t... Is, typename... Args>
+inline void InvokeAt(const Function &function, const Index *idx,
+                     std::index_sequence<Is...>, Args &...args) {
+  function(idx[Is]..., args...);
+}
+
+// Visit the flat indices [begin, end) of range in lexicographic order,
+// calling function(i0, ..., iN-1, args...). The innermost dimension is
+// run as a plain loop so the compiler sees the same code as the serial
+// path.
+template <std::size_t N, typename Index, typename Function, typename... Args>
+inline void ForEachInFlatRange(const MDRange<N, Index> &range, std::int64_t begin,
+                               std::int64_t end, const Function &function,
+                               Args &...args) {
+  if (begin >= end) return;
+  Index idx[N];
+  std::int64_t flat = begin;
+  for (std::size_t d = N; d-- > 0;) {
+    const std::int64_t extent = range.hi[d] - range.lo[d];
+    idx[d] = range.lo[d] + static_cast<Index>(flat % extent);
+    flat /= extent;
+  }
+  constexpr std::size_t last = N - 1;
+  std::int64_t remaining = end - begin;
+  while (remaining > 0) {
+    const Index stop = static_cast<Index>(
+        std::min<std::int64_t>(range.hi[last], idx[last] + remaining));
+    remaining -= stop - idx[last];
+    for (; idx[last] < stop; ++idx[last]) {
+      InvokeAt(function, idx, std::make_index_sequence<N>(), args...);
+    }
+    // carry into the slower dimensions
+    idx[last] = range.lo[last];
+    for (std::size_t d = last; d-- > 0;) {
+      if (++idx[d] < range.hi[d]) break;
+      idx[d] = range.lo[d];
+    }
+  }
+}
+
+// Tile extents requested as 0 are picked automatically: the innermost
+// (contiguous) dimension gets up to AUTO_TILE_INNER iterations so it
+// still vectorizes and streams, and the remaining dimensions share what
+// is left of a budget of AUTO_TILE_VOLUME iterations per tile, which
+// keeps a few fields' worth of a tile resident in L2.
+constexpr std::int64_t AUTO_TILE_VOLUME = 16384;
+constexpr int AUTO_TILE_INNER = 256;
+
+template <std::size_t N>
+struct TiledMDRange {
+  MDRange<N> range;
+  int tile[N];
+  int ntiles[N];
+
+  std::int64_t NumTiles() const {
+    if (range.Size() == 0) return 0;
+    std::int64_t n = 1;
+    for (std::size_t d = 0; d < N; ++d) {
+      n *= ntiles[d];
+    }
+    return n;
+  }
+
+  // The sub-range covered by the t-th tile, tiles in lexicographic order
+  MDRange<N> Tile(std::int64_t t) const {
+    MDRange<N> sub;
+    for (std::size_t d = N; d-- > 0;) {
+      const int it = static_cast<int>(t % ntiles[d]);
+      t /= ntiles[d];
+      sub.lo[d] = range.lo[d] + it * tile[d];
+      sub.hi[d] = std::min(range.hi[d], sub.lo[d] + tile[d]);
+    }
+    return sub;
+  }
+};
+
+template <std::size_t N>
+TiledMDRange<N> MakeTiledRange(const int (&lo)[N], const int (&hi)[N],
+                               const int (&requested)[N]) {
+  TiledMDRange<N> tiled;
+  std::copy(lo, lo + N, tiled.range.lo);
+  std::copy(hi, hi + N, tiled.range.hi);
+  std::int64_t budget = AUTO_TILE_VOLUME;
+  int nauto = 0;
+  for (std::size_t d = 0; d < N; ++d) {
+    const int extent = std::max(1, hi[d] - lo[d]);
+    if (requested[d] > 0) {
+      tiled.tile[d] = std::min(requested[d], extent);
+      budget /= tiled.tile[d];
+    } else if (d == N - 1) {
+      tiled.tile[d] = std::min(AUTO_TILE_INNER, extent);
+      budget /= tiled.tile[d];
+    } else {
+      tiled.tile[d] = 0;
+      nauto++;
+    }
+  }
+  // split what is left evenly over the outer automatic dimensions,
+  // innermost first so leftover budget flows outward
+  for (std::size_t d = N - 1; d-- > 0;) {
+    if (tiled.tile[d] > 0) continue;
+    const int extent = std::max(1, hi[d] - lo[d]);
+    int t = 1;
+    while (t < extent && IntPow(t + 1, nauto) <= budget) {
+      t++;
+    }
+    tiled.tile[d] = t;
+    budget = std::max<std::int64_t>(1, budget / t);
+    nauto--;
+  }
+  for (std::size_t d = 0; d < N; ++d) {
+    const int extent = std::max(1, hi[d] - lo[d]);
+    tiled.ntiles[d] = (extent + tiled.tile[d] - 1) / tiled.tile[d];
+  }
+  return tiled;
+}
+
+template <std::size_t N, typename Function>
+inline void ForEachInTile(const TiledMDRange<N> &tiled, std::int64_t t,
+                          const Function &function) {
+  const MDRange<N> sub = tiled.Tile(t);
+  ForEachInFlatRange(sub, 0, sub.Size(), function);
+}
+
+// Static partition of [0, n) into nblocks nearly equal contiguous pieces.
+inline std::pair<std::int64_t, std::int64_t> BlockBounds(std::int64_t n,
+                                                         std::int64_t nblocks,
+                                                         std::int64_t b) {
+  return {(n * b) / nblocks, (n * (b + 1)) / nblocks};
+}
+
+template <std::size_t N, typename Index, typename Function>
+void ParallelFor(ThreadPool &pool, const MDRange<N, Index> &range,
+                 const Function &function) {
+  const std::int64_t n = range.Size();
+  if (n == 0) return;
+  const std::int64_t nblocks = std::min<std::int64_t>(n, pool.Concurrency());
+  pool.ForEachBlock(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(n, nblocks, b);
+    ForEachInFlatRange(range, begin, end, function);
+  });
+}
+
+// Each block accumulates into its own value-initialized partial, and
+// the partials are added to reduced in block order, so the result
+// matches the serial host loop whenever T's addition is associative.
+template <std::size_t N, typename Index, typename Function, typename T>
+void ParallelReduce(ThreadPool &pool, const MDRange<N, Index> &range,
+                    const Function &function, T &reduced) {
+  const std::int64_t n = range.Size();
+  if (n == 0) return;
+  const std::int64_t nblocks = std::min<std::int64_t>(n, pool.Concurrency());
+  std::unique_ptr<T[]> partials(new T[nblocks]());
+  pool.ForEachBlock(nblocks, [&](std::int64_t b) {
+    const auto [begin, end] = BlockBounds(n, nblocks, b);
+    T local{};
+    ForEachInFlatRange(range, begin, end, function, local);
+    partials[b] = local;
+  });
+  for (std::int64_t b = 0; b < nblocks; ++b) {
+    reduced += partials[b];
+  }
+}
+
+// Entry points used by portableFor/portableReduce, running on the
+// global pool.
+template <std::size_t N, typename Index, typename Function>
+void ParallelFor(const Index (&lo)[N], const Index (&hi)[N], const Function &function) {
+  MDRange<N, Index> range;
+  std::copy(lo, lo + N, range.lo);
+  std::copy(hi, hi + N, range.hi);
+  ParallelFor(ThreadPool::Global(), range, function);
+}
+
+template <std::size_t N, typename Index, typename Function, typename T>
+void ParallelReduce(const Index (&lo)[N], const Index (&hi)[N], const Function &function,
+                    T &reduced) {
+  MDRange<N, Index> range;
+  std::copy(lo, lo + N, range.lo);
+  std::copy(hi, hi + N, range.hi);
+  ParallelReduce(ThreadPool::Global(), range, function, reduced);
+}
+
+} // namespace impl
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_MD_RANGE_HPP_
@@ -0,0 +1,212 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_MEMORY_POOL_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_MEMORY_POOL_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// A caching allocator behind portableMalloc and portableFree, one per
+// memory space (see MemoryPoolOf). Requests are rounded up to a size
+// class, at most a quarter above the request, and freed blocks are
+// kept on a free list per class, to be handed out again without
+// calling the underlying allocator. Cached bytes never exceed the
+// capacity; blocks freed beyond it go back to the underlying
+// allocator. The capacity is 0, so caching is off, unless set with
+// SetCapacity or PORTS_OF_CALL_MEMORY_POOL_CAPACITY (in bytes, or with
+// a K, M or G suffix). All members are thread-safe.
+//
+// Work already launched may still use a block when it is freed, e.g.
+// on another execution space instance. cudaFree and kokkos_free wait
+// for that work, but a cached block is handed out again at once, so a
+// pool given a fence function calls it before caching a freed block.
+// A pool without one (host memory outside Kokkos) relies on the
+// caller, as std::free does.
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace PortsOfCall {
+
+struct MemoryPoolStats {
+  // allocations served from the cache, and those that were not
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  // bytes in blocks held on free lists, and in blocks handed out
+  std::size_t bytes_cached = 0;
+  std::size_t bytes_in_use = 0;
+  std::size_t capacity = 0;
+};
+
+class MemoryPool {
+ public:
+  using AllocateFunction = void *(*)(std::size_t);
+  using FreeFunction = void (*)(void *);
+  using FenceFunction = void (*)();
+
+  MemoryPool(AllocateFunction allocate, FreeFunction free, FenceFunction fence = nullptr)
+      : allocate_(allocate), free_(free), fence_(fence), capacity_(DefaultCapacity()) {}
+  ~MemoryPool() { Trim(); }
+  MemoryPool(const MemoryPool &) = delete;
+  MemoryPool &operator=(const MemoryPool &) = delete;
+
+  // Capacity from PORTS_OF_CALL_MEMORY_POOL_CAPACITY, e.g. 512M
+  static std::size_t DefaultCapacity() {
+    const char *env = std::getenv("PORTS_OF_CALL_MEMORY_POOL_CAPACITY");
+    if (env == nullptr) return 0;
+    char *suffix = nullptr;
+    const double value = std::strtod(env, &suffix);
+    double scale = 1;
+    if (*suffix == 'K' || *suffix == 'k') scale = 1 << 10;
+    if (*suffix == 'M' || *suffix == 'm') scale = 1 << 20;
+    if (*suffix == 'G' || *suffix == 'g') scale = 1 << 30;
+    return value > 0 ? static_cast<std::size_t>(value * scale) : 0;
+  }
+
+  // The bytes actually allocated for a request of bytes
+  static std::size_t ClassSize(std::size_t bytes) {
+    constexpr std::size_t smallest = 256;
+    if (bytes <= smallest) return smallest;
+    const std::size_t step = std::bit_floor(bytes - 1) / 4;
+    return (bytes + step - 1) / step * step;
+  }
+
+  std::size_t Capacity() const { return capacity_.load(std::memory_order_relaxed); }
+  // Lowering the capacity releases cached blocks until they fit
+  void SetCapacity(std::size_t bytes) {
+    capacity_.store(bytes, std::memory_order_relaxed);
+    Release(bytes);
+  }
+  // Returns every cached block to the underlying allocator
+  void Trim() { Release(0); }
+
+  MemoryPoolStats Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryPoolStats stats = stats_;
+    stats.capacity = Capacity();
+    return stats;
+  }
+  void ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.hits = stats_.misses = 0;
+  }
+
+  void *Allocate(std::size_t bytes) {
+    const std::size_t size = ClassSize(bytes);
+    if (bytes == 0 || size > Capacity()) return allocate_(bytes);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &blocks = free_lists_[size];
+      if (!blocks.empty()) {
+        void *p = blocks.back();
+        blocks.pop_back();
+        stats_.hits++;
+        stats_.bytes_cached -= size;
+        Track(p, size);
+        return p;
+      }
+      stats_.misses++;
+    }
+    void *p = nullptr;
+    try {
+      p = allocate_(size);
+    } catch (...) {
+      if (!ReleaseAll()) throw;
+      p = allocate_(size);
+    }
+    if (p == nullptr && ReleaseAll()) p = allocate_(size);
+    if (p == nullptr) return p;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Track(p, size);
+    return p;
+  }
+
+  void Free(void *p) {
+    if (p == nullptr) return;
+    if (nlive_.load(std::memory_order_acquire) > 0) {
+      // before the block can be handed out again
+      if (fence_ != nullptr) fence_();
+      std::unique_lock<std::mutex> lock(mutex_);
+      const auto it = live_.find(p);
+      if (it != live_.end()) {
+        const std::size_t size = it->second;
+        live_.erase(it);
+        nlive_.fetch_sub(1, std::memory_order_release);
+        stats_.bytes_in_use -= size;
+        if (stats_.bytes_cached + size <= Capacity()) {
+          free_lists_[size].push_back(p);
+          stats_.bytes_cached += size;
+          return;
+        }
+      }
+    }
+    free_(p);
+  }
+
+ private:
+  // with mutex_ held
+  void Track(void *p, std::size_t size) {
+    live_.emplace(p, size);
+    nlive_.fetch_add(1, std::memory_order_release);
+    stats_.bytes_in_use += size;
+  }
+
+  // Frees cached blocks, largest first, until at most target bytes
+  // are cached
+  void Release(std::size_t target) {
+    std::vector<void *> released;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto it = free_lists_.rbegin();
+           it != free_lists_.rend() && stats_.bytes_cached > target; ++it) {
+        auto &blocks = it->second;
+        while (!blocks.empty() && stats_.bytes_cached > target) {
+          released.push_back(blocks.back());
+          blocks.pop_back();
+          stats_.bytes_cached -= it->first;
+        }
+      }
+    }
+    for (void *p : released) {
+      free_(p);
+    }
+  }
+  // Frees every cached block, if any, for a retry of a failed allocation
+  bool ReleaseAll() {
+    if (Stats().bytes_cached == 0) return false;
+    Trim();
+    return true;
+  }
+
+  AllocateFunction allocate_;
+  FreeFunction free_;
+  FenceFunction fence_;
+  std::atomic<std::size_t> capacity_;
+  mutable std::mutex mutex_;
+  MemoryPoolStats stats_;
+  std::map<std::size_t, std::vector<void *>> free_lists_;
+  std::unordered_map<void *, std::size_t> live_;
+  std::atomic<std::size_t> nlive_{0};
+};
+
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_MEMORY_POOL_HPP_
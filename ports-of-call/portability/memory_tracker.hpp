@@ -0,0 +1,238 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_MEMORY_TRACKER_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_MEMORY_TRACKER_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Accounting of the memory handed out by portableMalloc, one tracker
+// per memory space (see MemoryStatsOf). Tracking is off unless turned
+// on with MemoryTracking::Enable or PORTS_OF_CALL_MEMORY_TRACKING=on;
+// with =report the outstanding allocations are also reported at exit.
+// While off, an allocation costs one atomic load, and so does freeing
+// once nothing tracked is live. Only allocations made while tracking
+// is on are counted. Sizes are those requested, so memory cached by
+// the memory pool does not count as live.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PortsOfCall {
+
+struct MemoryStats {
+  std::size_t live_bytes = 0;
+  std::size_t high_water_bytes = 0;
+  std::size_t live_allocations = 0;
+  // allocations and frees since tracking began
+  std::size_t allocations = 0;
+  std::size_t frees = 0;
+};
+
+namespace impl {
+class MemoryTracker {
+ public:
+  struct Allocation {
+    const void *pointer;
+    std::size_t bytes;
+    // the label from MallocOptions, or empty
+    std::string label;
+  };
+
+  explicit MemoryTracker(std::string name) : name_(std::move(name)) {}
+  MemoryTracker(const MemoryTracker &) = delete;
+  MemoryTracker &operator=(const MemoryTracker &) = delete;
+
+  const std::string &Name() const { return name_; }
+
+  void Track(void *p, std::size_t bytes, const char *label) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_.insert_or_assign(p, Record{bytes, label ? label : ""});
+    nlive_.store(live_.size(), std::memory_order_release);
+    stats_.live_bytes += bytes;
+    stats_.high_water_bytes = std::max(stats_.high_water_bytes, stats_.live_bytes);
+    stats_.allocations++;
+  }
+  void Untrack(void *p) {
+    if (p == nullptr || nlive_.load(std::memory_order_acquire) == 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = live_.find(p);
+    if (it == live_.end()) return;
+    stats_.live_bytes -= it->second.bytes;
+    stats_.frees++;
+    live_.erase(it);
+    nlive_.store(live_.size(), std::memory_order_release);
+  }
+
+  MemoryStats Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryStats stats = stats_;
+    stats.live_allocations = live_.size();
+    return stats;
+  }
+  // Restarts the high-water mark and counts from what is live now
+  void ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.high_water_bytes = stats_.live_bytes;
+    stats_.allocations = stats_.frees = 0;
+  }
+
+  // Live allocations, largest first
+  std::vector<Allocation> Outstanding() const {
+    std::vector<Allocation> outstanding;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      outstanding.reserve(live_.size());
+      for (const auto &[p, record] : live_) {
+        outstanding.push_back({p, record.bytes, record.label});
+      }
+    }
+    std::sort(outstanding.begin(), outstanding.end(),
+              [](const auto &a, const auto &b) { return a.bytes > b.bytes; });
+    return outstanding;
+  }
+
+ private:
+  struct Record {
+    std::size_t bytes;
+    std::string label;
+  };
+
+  std::string name_;
+  mutable std::mutex mutex_;
+  MemoryStats stats_;
+  std::unordered_map<void *, Record> live_;
+  std::atomic<std::size_t> nlive_{0};
+};
+
+// 1536 -> "1.5 KiB"
+inline std::string FormatBytes(std::size_t bytes) {
+  const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  double value = static_cast<double>(bytes);
+  int u = 0;
+  while (value >= 1024 && u < 4) {
+    value /= 1024;
+    u++;
+  }
+  char text[32];
+  std::snprintf(text, sizeof(text), u == 0 ? "%.0f %s" : "%.1f %s", value, units[u]);
+  return text;
+}
+
+class MemoryTrackers {
+ public:
+  static MemoryTrackers &Get() {
+    static MemoryTrackers trackers;
+    // registered once trackers is constructed, so it runs before
+    // trackers is destroyed
+    static const bool at_exit = (std::atexit([]() {
+                                   if (Get().report_at_exit) Get().Report(std::cerr);
+                                 }),
+                                 true);
+    (void)at_exit;
+    return trackers;
+  }
+
+  MemoryTracker &Add(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    trackers_.push_back(std::make_unique<MemoryTracker>(name));
+    return *trackers_.back();
+  }
+
+  void ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &tracker : trackers_) {
+      tracker->ResetStats();
+    }
+  }
+
+  void Report(std::ostream &os, std::size_t max_listed = 32) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    os << "ports-of-call memory report\n";
+    for (const auto &tracker : trackers_) {
+      const MemoryStats stats = tracker->Stats();
+      os << "  " << tracker->Name() << ": " << FormatBytes(stats.live_bytes)
+         << " live in " << stats.live_allocations << " allocations, high water "
+         << FormatBytes(stats.high_water_bytes) << ", " << stats.allocations
+         << " allocations and " << stats.frees << " frees\n";
+      const auto outstanding = tracker->Outstanding();
+      const std::size_t nlisted = std::min(max_listed, outstanding.size());
+      for (std::size_t i = 0; i < nlisted; i++) {
+        const auto &a = outstanding[i];
+        os << "    " << FormatBytes(a.bytes) << " at " << a.pointer;
+        if (!a.label.empty()) os << " (" << a.label << ")";
+        os << "\n";
+      }
+      if (outstanding.size() > nlisted) {
+        os << "    ... and " << outstanding.size() - nlisted << " more\n";
+      }
+    }
+  }
+
+  std::atomic<bool> enabled{DefaultMode() != Mode::Off};
+  std::atomic<bool> report_at_exit{DefaultMode() == Mode::Report};
+
+ private:
+  enum class Mode { Off, On, Report };
+  // From PORTS_OF_CALL_MEMORY_TRACKING: on (or 1) or report
+  static Mode DefaultMode() {
+    const char *env = std::getenv("PORTS_OF_CALL_MEMORY_TRACKING");
+    if (env == nullptr) return Mode::Off;
+    if (std::strcmp(env, "report") == 0) return Mode::Report;
+    if (std::strcmp(env, "on") == 0 || std::strcmp(env, "1") == 0) return Mode::On;
+    return Mode::Off;
+  }
+
+  MemoryTrackers() = default;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<MemoryTracker>> trackers_;
+};
+} // namespace impl
+
+namespace MemoryTracking {
+// Track allocations made from now on
+inline void Enable(bool on = true) {
+  impl::MemoryTrackers::Get().enabled.store(on, std::memory_order_relaxed);
+}
+inline bool Enabled() {
+  return impl::MemoryTrackers::Get().enabled.load(std::memory_order_relaxed);
+}
+// Print Report to std::cerr when the program exits
+inline void ReportAtExit(bool on = true) {
+  impl::MemoryTrackers::Get().report_at_exit.store(on, std::memory_order_relaxed);
+}
+// Statistics for every space, and the largest max_listed live
+// allocations of each with their labels
+inline void Report(std::ostream &os, std::size_t max_listed = 32) {
+  impl::MemoryTrackers::Get().Report(os, max_listed);
+}
+inline void ResetStats() { impl::MemoryTrackers::Get().ResetStats(); }
+} // namespace MemoryTracking
+
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_MEMORY_TRACKER_HPP_
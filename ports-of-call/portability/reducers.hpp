@@ -0,0 +1,267 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_REDUCERS_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_REDUCERS_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Reducer objects for portableReduce. A reducer wraps a reference to
+// the result and knows how to initialize and combine partial values:
+//
+//   Real dtmin;
+//   portableReduce("dt", 0, n, PORTABLE_LAMBDA(int i, Real &v) {
+//     v = std::min(v, dt(i));
+//   }, PortsOfCall::Min<Real>(dtmin));
+//
+// Under Kokkos these are the Kokkos reducers. Otherwise they are small
+// classes with the same interface (reducer, value_type, init, join,
+// reference), so anything written against one works with the other.
+// Every portableReduce given reducers overwrites the referenced results.
+//
+// Reducers for user types derive from Reducer and supply init, join
+// and, optionally, final, which is applied once to the fully joined
+// result before portableReduce returns:
+//
+//   struct Stats { Real sum; int count; };
+//   struct Mean : PortsOfCall::Reducer<Mean, Stats> {
+//     using Reducer::Reducer;
+//     PORTABLE_INLINE_FUNCTION void init(Stats &s) const { s = {0, 0}; }
+//     PORTABLE_INLINE_FUNCTION void join(Stats &d, const Stats &s) const {
+//       d.sum += s.sum;
+//       d.count += s.count;
+//     }
+//     void final(Stats &s) const { s.sum /= s.count; }
+//   };
+//
+// join must be associative, as partial results are joined in an order
+// that depends on the backend and, except in Deterministic mode, on
+// the number of threads.
+
+#include <limits>
+#include <type_traits>
+
+namespace PortsOfCall {
+
+// Base of reducers: holds the reference to the result, Derived
+// supplies init, join and optionally final. Under Kokkos it also
+// provides what Kokkos requires of a custom reducer.
+template <typename Derived, typename T>
+class Reducer {
+ public:
+  using reducer = Derived;
+  using value_type = std::remove_cv_t<T>;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  using result_view_type =
+      Kokkos::View<value_type, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+  explicit Reducer(value_type &value) : value_(&value) {}
+  PORTABLE_INLINE_FUNCTION value_type &reference() const { return *value_; }
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  result_view_type view() const { return result_view_type(value_); }
+  bool references_scalar() const { return true; }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+ private:
+  value_type *value_;
+};
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+template <typename T>
+using Sum = Kokkos::Sum<T>;
+template <typename T>
+using Prod = Kokkos::Prod<T>;
+template <typename T>
+using Min = Kokkos::Min<T>;
+template <typename T>
+using Max = Kokkos::Max<T>;
+template <typename T>
+using LAnd = Kokkos::LAnd<T>;
+template <typename T>
+using LOr = Kokkos::LOr<T>;
+template <typename T, typename I>
+using ValLoc = Kokkos::ValLocScalar<T, I>;
+template <typename T, typename I>
+using MinLoc = Kokkos::MinLoc<T, I>;
+template <typename T, typename I>
+using MaxLoc = Kokkos::MaxLoc<T, I>;
+#else
+template <typename T>
+struct Sum : Reducer<Sum<T>, T> {
+  using Reducer<Sum<T>, T>::Reducer;
+  using value_type = std::remove_cv_t<T>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const { v = value_type(0); }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    dest += src;
+  }
+};
+
+template <typename T>
+struct Prod : Reducer<Prod<T>, T> {
+  using Reducer<Prod<T>, T>::Reducer;
+  using value_type = std::remove_cv_t<T>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const { v = value_type(1); }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    dest *= src;
+  }
+};
+
+template <typename T>
+struct Min : Reducer<Min<T>, T> {
+  using Reducer<Min<T>, T>::Reducer;
+  using value_type = std::remove_cv_t<T>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const {
+    v = std::numeric_limits<value_type>::max();
+  }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    if (src < dest) dest = src;
+  }
+};
+
+template <typename T>
+struct Max : Reducer<Max<T>, T> {
+  using Reducer<Max<T>, T>::Reducer;
+  using value_type = std::remove_cv_t<T>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const {
+    v = std::numeric_limits<value_type>::lowest();
+  }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    if (src > dest) dest = src;
+  }
+};
+
+template <typename T>
+struct LAnd : Reducer<LAnd<T>, T> {
+  using Reducer<LAnd<T>, T>::Reducer;
+  using value_type = std::remove_cv_t<T>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const { v = value_type(1); }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    dest = dest && src;
+  }
+};
+
+template <typename T>
+struct LOr : Reducer<LOr<T>, T> {
+  using Reducer<LOr<T>, T>::Reducer;
+  using value_type = std::remove_cv_t<T>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const { v = value_type(0); }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    dest = dest || src;
+  }
+};
+
+// A value and the index where it occurred, as used by MinLoc/MaxLoc
+template <typename T, typename I>
+struct ValLoc {
+  T val;
+  I loc;
+};
+
+// Ties are broken toward the smaller location, so the answer does not
+// depend on how the index space was split across threads.
+template <typename T, typename I>
+struct MinLoc : Reducer<MinLoc<T, I>, ValLoc<T, I>> {
+  using Reducer<MinLoc<T, I>, ValLoc<T, I>>::Reducer;
+  using value_type = ValLoc<T, I>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const {
+    v.val = std::numeric_limits<T>::max();
+    v.loc = std::numeric_limits<I>::max();
+  }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    if (src.val < dest.val || (src.val == dest.val && src.loc < dest.loc)) dest = src;
+  }
+};
+
+template <typename T, typename I>
+struct MaxLoc : Reducer<MaxLoc<T, I>, ValLoc<T, I>> {
+  using Reducer<MaxLoc<T, I>, ValLoc<T, I>>::Reducer;
+  using value_type = ValLoc<T, I>;
+  PORTABLE_INLINE_FUNCTION void init(value_type &v) const {
+    v.val = std::numeric_limits<T>::lowest();
+    v.loc = std::numeric_limits<I>::max();
+  }
+  PORTABLE_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    if (src.val > dest.val || (src.val == dest.val && src.loc < dest.loc)) dest = src;
+  }
+};
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+// A reducer is any class R with R::reducer naming R itself, following
+// the Kokkos convention.
+template <typename R, typename = void>
+struct is_reducer : std::false_type {};
+template <typename R>
+struct is_reducer<R, std::void_t<typename R::reducer>>
+    : std::is_same<typename R::reducer, std::remove_cv_t<R>> {};
+template <typename R>
+constexpr bool is_reducer_v =
+    is_reducer<std::remove_cv_t<std::remove_reference_t<R>>>::value;
+
+// True if Rs is a non-empty pack of reducers
+template <typename... Rs>
+constexpr bool are_reducers_v = (sizeof...(Rs) > 0) && (is_reducer_v<Rs> && ...);
+
+// True if reducer R has the optional final(value_type &)
+template <typename R>
+constexpr bool has_final_v =
+    requires(const R &r, typename R::value_type &v) { r.final(v); };
+
+namespace impl {
+// Applies the reducer's final, if it has one, to its result
+template <typename R>
+void Finalize(const R &reducer) {
+  if constexpr (has_final_v<R>) reducer.final(reducer.reference());
+}
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+// R without its final, so that final is applied by Finalize alone
+// whatever the Kokkos version does with a reducer's final
+template <typename R>
+struct WithoutFinal {
+  using reducer = WithoutFinal;
+  using value_type = typename R::value_type;
+  using result_view_type = typename R::result_view_type;
+  R r;
+  KOKKOS_INLINE_FUNCTION void init(value_type &v) const { r.init(v); }
+  KOKKOS_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const {
+    r.join(dest, src);
+  }
+  KOKKOS_INLINE_FUNCTION value_type &reference() const { return r.reference(); }
+  result_view_type view() const { return r.view(); }
+  bool references_scalar() const { return r.references_scalar(); }
+};
+template <typename R>
+auto HideFinal(const R &reducer) {
+  if constexpr (has_final_v<R>) {
+    return WithoutFinal<R>{reducer};
+  } else {
+    return reducer;
+  }
+}
+
+// Kokkos::parallel_reduce into reducers, then their finals
+template <typename Policy, typename Function, typename... Reducers>
+void KokkosReduce(const char *name, const Policy &policy, const Function &function,
+                  const Reducers &...reducers) {
+  Kokkos::parallel_reduce(name, policy, function, HideFinal(reducers)...);
+  (Finalize(reducers), ...);
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+} // namespace impl
+
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_REDUCERS_HPP_
@@ -0,0 +1,452 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_SIMD_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_SIMD_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Fixed-width SIMD values for portableForSimd. A Simd<T, W> holds W
+// lanes of T and a SimdMask<W> one flag per lane. Every operation is a
+// loop over the lanes marked for vectorization, so the compiler emits
+// vector instructions for whatever the target supports without any
+// intrinsics, and the same code runs (one lane at a time) on devices:
+//
+//   portableForSimd("eos", 0, n, PORTABLE_LAMBDA(const PortsOfCall::SimdIndex<> &i) {
+//     const auto rho = PortsOfCall::SimdLoad(rho_ptr, i);
+//     const auto sie = PortsOfCall::SimdLoad(sie_ptr, i);
+//     PortsOfCall::SimdStore(p_ptr, i, gm1 * rho * sie);
+//   });
+//
+// The default width fills one native register, POC_SIMD_BYTES wide,
+// which is taken from the target (64 bytes with AVX-512, 32 with AVX,
+// 16 otherwise) unless defined by the user. Math functions mirror the
+// std names and are found by argument-dependent lookup.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#ifndef POC_SIMD_BYTES
+#if defined(__AVX512F__)
+#define POC_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define POC_SIMD_BYTES 32
+#else
+#define POC_SIMD_BYTES 16
+#endif
+#endif // POC_SIMD_BYTES
+
+namespace PortsOfCall {
+
+// Lanes of T that fill one native vector register
+template <typename T>
+constexpr int simd_width_v = std::max(1, static_cast<int>(POC_SIMD_BYTES / sizeof(T)));
+
+template <int W>
+class SimdMask {
+ public:
+  SimdMask() = default;
+  PORTABLE_FORCEINLINE_FUNCTION explicit SimdMask(bool value) {
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      m_[l] = value;
+    }
+  }
+  // The first n lanes set, the rest clear
+  PORTABLE_FORCEINLINE_FUNCTION static SimdMask FirstN(int n) {
+    SimdMask mask;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      mask.m_[l] = l < n;
+    }
+    return mask;
+  }
+
+  PORTABLE_FORCEINLINE_FUNCTION bool operator[](int l) const { return m_[l]; }
+  PORTABLE_FORCEINLINE_FUNCTION bool &operator[](int l) { return m_[l]; }
+
+  PORTABLE_FORCEINLINE_FUNCTION int Count() const {
+    int n = 0;
+    for (int l = 0; l < W; l++) {
+      n += m_[l];
+    }
+    return n;
+  }
+  PORTABLE_FORCEINLINE_FUNCTION bool Any() const { return Count() > 0; }
+  PORTABLE_FORCEINLINE_FUNCTION bool All() const { return Count() == W; }
+  PORTABLE_FORCEINLINE_FUNCTION bool None() const { return Count() == 0; }
+
+  PORTABLE_FORCEINLINE_FUNCTION friend SimdMask operator&&(const SimdMask &a,
+                                                           const SimdMask &b) {
+    SimdMask out;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      out.m_[l] = a.m_[l] && b.m_[l];
+    }
+    return out;
+  }
+  PORTABLE_FORCEINLINE_FUNCTION friend SimdMask operator||(const SimdMask &a,
+                                                           const SimdMask &b) {
+    SimdMask out;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      out.m_[l] = a.m_[l] || b.m_[l];
+    }
+    return out;
+  }
+  PORTABLE_FORCEINLINE_FUNCTION friend SimdMask operator!(const SimdMask &a) {
+    SimdMask out;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      out.m_[l] = !a.m_[l];
+    }
+    return out;
+  }
+
+ private:
+  bool m_[W];
+};
+
+namespace impl {
+// Storage for the lanes of a Simd. Host compilers with vector
+// extensions get a native vector whenever its size is a power of two,
+// so arithmetic maps onto single vector instructions rather than
+// depending on the vectorizer, which gives up on wide packs. Devices
+// and other compilers use a plain array.
+template <typename T, int W>
+struct SimdStorage {
+  static constexpr bool native = false;
+  using type = T[W];
+};
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__) &&                 \
+    !defined(__HIPCC__) && !defined(__SYCL_DEVICE_ONLY__)
+template <typename T, int W>
+  requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+           std::has_single_bit(sizeof(T) * W))
+struct SimdStorage<T, W> {
+  static constexpr bool native = true;
+  typedef T type __attribute__((vector_size(sizeof(T) * W)));
+};
+#endif
+} // namespace impl
+
+template <typename T, int W = simd_width_v<T>>
+class Simd {
+  static constexpr bool native = impl::SimdStorage<T, W>::native;
+
+ public:
+  using value_type = T;
+  using mask_type = SimdMask<W>;
+  static constexpr int width = W;
+
+  Simd() = default;
+  // Broadcast, so scalars mix freely with packs in expressions
+  PORTABLE_FORCEINLINE_FUNCTION Simd(T value) {
+    if constexpr (native) {
+      v_ = value - Storage{};
+    } else {
+      POC_SIMD_LOOP
+      for (int l = 0; l < W; l++) {
+        v_[l] = value;
+      }
+    }
+  }
+
+  PORTABLE_FORCEINLINE_FUNCTION static Simd Load(const T *p) {
+    Simd x;
+    if constexpr (native) {
+      __builtin_memcpy(&x.v_, p, sizeof(Storage));
+    } else {
+      POC_SIMD_LOOP
+      for (int l = 0; l < W; l++) {
+        x.v_[l] = p[l];
+      }
+    }
+    return x;
+  }
+  // Lanes outside mask are not read and are set to fill
+  PORTABLE_FORCEINLINE_FUNCTION static Simd Load(const T *p, const mask_type &mask,
+                                                 T fill = T()) {
+    Simd x;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      x[l] = mask[l] ? p[l] : fill;
+    }
+    return x;
+  }
+  template <typename I>
+  PORTABLE_FORCEINLINE_FUNCTION static Simd
+  Gather(const T *p, const Simd<I, W> &index, const mask_type &mask = mask_type(true),
+         T fill = T()) {
+    Simd x;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      x[l] = mask[l] ? p[index[l]] : fill;
+    }
+    return x;
+  }
+
+  PORTABLE_FORCEINLINE_FUNCTION void Store(T *p) const {
+    if constexpr (native) {
+      __builtin_memcpy(p, &v_, sizeof(Storage));
+    } else {
+      POC_SIMD_LOOP
+      for (int l = 0; l < W; l++) {
+        p[l] = v_[l];
+      }
+    }
+  }
+  // Lanes outside mask are not written
+  PORTABLE_FORCEINLINE_FUNCTION void Store(T *p, const mask_type &mask) const {
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      if (mask[l]) p[l] = (*this)[l];
+    }
+  }
+
+  // Vector types share the alias set of their elements, so lanes of
+  // either kind of storage may be addressed through a T pointer.
+  PORTABLE_FORCEINLINE_FUNCTION T operator[](int l) const {
+    return reinterpret_cast<const T *>(&v_)[l];
+  }
+  PORTABLE_FORCEINLINE_FUNCTION T &operator[](int l) {
+    return reinterpret_cast<T *>(&v_)[l];
+  }
+
+  PORTABLE_FORCEINLINE_FUNCTION friend Simd operator-(const Simd &a) {
+    Simd out;
+    if constexpr (native) {
+      out.v_ = -a.v_;
+    } else {
+      POC_SIMD_LOOP
+      for (int l = 0; l < W; l++) {
+        out.v_[l] = -a.v_[l];
+      }
+    }
+    return out;
+  }
+
+#define POC_SIMD_BINARY_OP(OP)                                                           \
+  PORTABLE_FORCEINLINE_FUNCTION friend Simd operator OP(const Simd &a, const Simd &b) {  \
+    Simd out;                                                                            \
+    if constexpr (native) {                                                              \
+      out.v_ = a.v_ OP b.v_;                                                             \
+    } else {                                                                             \
+      POC_SIMD_LOOP                                                                      \
+      for (int l = 0; l < W; l++) {                                                      \
+        out.v_[l] = a.v_[l] OP b.v_[l];                                                  \
+      }                                                                                  \
+    }                                                                                    \
+    return out;                                                                          \
+  }                                                                                      \
+  PORTABLE_FORCEINLINE_FUNCTION Simd &operator OP##=(const Simd &b) {                    \
+    return *this = *this OP b;                                                           \
+  }
+  POC_SIMD_BINARY_OP(+)
+  POC_SIMD_BINARY_OP(-)
+  POC_SIMD_BINARY_OP(*)
+  POC_SIMD_BINARY_OP(/)
+#undef POC_SIMD_BINARY_OP
+
+#define POC_SIMD_COMPARE_OP(OP)                                                          \
+  PORTABLE_FORCEINLINE_FUNCTION friend mask_type operator OP(const Simd &a,              \
+                                                             const Simd &b) {            \
+    mask_type out;                                                                       \
+    POC_SIMD_LOOP                                                                        \
+    for (int l = 0; l < W; l++) {                                                        \
+      out[l] = a[l] OP b[l];                                                             \
+    }                                                                                    \
+    return out;                                                                          \
+  }
+  POC_SIMD_COMPARE_OP(<)
+  POC_SIMD_COMPARE_OP(<=)
+  POC_SIMD_COMPARE_OP(>)
+  POC_SIMD_COMPARE_OP(>=)
+  POC_SIMD_COMPARE_OP(==)
+  POC_SIMD_COMPARE_OP(!=)
+#undef POC_SIMD_COMPARE_OP
+
+ private:
+  using Storage = typename impl::SimdStorage<T, W>::type;
+  // aligned to the whole pack when that is a power of two
+  static constexpr std::size_t alignment =
+      std::has_single_bit(sizeof(T) * W) ? sizeof(T) * W : alignof(T);
+  alignas(alignment) Storage v_;
+};
+
+namespace impl {
+template <typename T>
+struct SimdTraits {
+  static constexpr bool is_simd = false;
+  static constexpr int width = 0;
+};
+template <typename T, int W>
+struct SimdTraits<Simd<T, W>> {
+  static constexpr bool is_simd = true;
+  static constexpr int width = W;
+};
+
+template <typename A>
+PORTABLE_FORCEINLINE_FUNCTION auto Lane(const A &a, [[maybe_unused]] int l) {
+  if constexpr (SimdTraits<A>::is_simd) {
+    return a[l];
+  } else {
+    return a;
+  }
+}
+} // namespace impl
+
+template <typename T>
+constexpr bool is_simd_v = impl::SimdTraits<std::remove_cvref_t<T>>::is_simd;
+
+// Apply a scalar function lane by lane. Scalar arguments are used in
+// every lane, and all packs must have the same width.
+template <typename Function, typename... Args>
+PORTABLE_FORCEINLINE_FUNCTION auto SimdMap(const Function &function,
+                                           const Args &...args) {
+  constexpr int W = std::max({impl::SimdTraits<Args>::width...});
+  static_assert(W > 0, "SimdMap needs at least one Simd argument");
+  static_assert(((impl::SimdTraits<Args>::width == 0 ||
+                  impl::SimdTraits<Args>::width == W) &&
+                 ...),
+                "Simd arguments must have the same width");
+  using R = std::decay_t<decltype(function(impl::Lane(args, 0)...))>;
+  Simd<R, W> out;
+  POC_SIMD_LOOP
+  for (int l = 0; l < W; l++) {
+    out[l] = function(impl::Lane(args, l)...);
+  }
+  return out;
+}
+
+// Lane l of the result is a[l] where mask[l] is set and b[l] elsewhere
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION Simd<T, W> Select(const SimdMask<W> &mask,
+                                                const Simd<T, W> &a,
+                                                const Simd<T, W> &b) {
+  Simd<T, W> out;
+  POC_SIMD_LOOP
+  for (int l = 0; l < W; l++) {
+    out[l] = mask[l] ? a[l] : b[l];
+  }
+  return out;
+}
+
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION T ReduceAdd(const Simd<T, W> &x) {
+  T sum = x[0];
+  for (int l = 1; l < W; l++) {
+    sum += x[l];
+  }
+  return sum;
+}
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION T ReduceMin(const Simd<T, W> &x) {
+  T m = x[0];
+  for (int l = 1; l < W; l++) {
+    m = x[l] < m ? x[l] : m;
+  }
+  return m;
+}
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION T ReduceMax(const Simd<T, W> &x) {
+  T m = x[0];
+  for (int l = 1; l < W; l++) {
+    m = x[l] > m ? x[l] : m;
+  }
+  return m;
+}
+
+#define POC_SIMD_UNARY_FUNCTION(NAME)                                                    \
+  template <typename T, int W>                                                           \
+  PORTABLE_FORCEINLINE_FUNCTION Simd<T, W> NAME(const Simd<T, W> &x) {                   \
+    return SimdMap([](const T v) { return static_cast<T>(std::NAME(v)); }, x);           \
+  }
+POC_SIMD_UNARY_FUNCTION(abs)
+POC_SIMD_UNARY_FUNCTION(sqrt)
+POC_SIMD_UNARY_FUNCTION(cbrt)
+POC_SIMD_UNARY_FUNCTION(exp)
+POC_SIMD_UNARY_FUNCTION(log)
+#undef POC_SIMD_UNARY_FUNCTION
+
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION Simd<T, W> min(const Simd<T, W> &a, const Simd<T, W> &b) {
+  return Select(b < a, b, a);
+}
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION Simd<T, W> max(const Simd<T, W> &a, const Simd<T, W> &b) {
+  return Select(a < b, b, a);
+}
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION Simd<T, W> pow(const Simd<T, W> &base,
+                                             const Simd<T, W> &exponent) {
+  return SimdMap([](const T b, const T e) { return static_cast<T>(std::pow(b, e)); },
+                 base, exponent);
+}
+
+// The indices of one pack of a portableForSimd loop: lanes first,
+// first + 1, ..., of which the leading Count() are in range.
+template <int W = simd_width_v<Real>>
+class SimdIndex {
+ public:
+  static constexpr int width = W;
+
+  PORTABLE_FORCEINLINE_FUNCTION SimdIndex(int first, int count)
+      : first_(first), count_(count) {}
+
+  PORTABLE_FORCEINLINE_FUNCTION int First() const { return first_; }
+  PORTABLE_FORCEINLINE_FUNCTION int Count() const { return count_; }
+  // True unless this is the remainder pack at the end of the range
+  PORTABLE_FORCEINLINE_FUNCTION bool Full() const { return count_ == W; }
+  PORTABLE_FORCEINLINE_FUNCTION int operator[](int l) const { return first_ + l; }
+  PORTABLE_FORCEINLINE_FUNCTION SimdMask<W> Mask() const {
+    return SimdMask<W>::FirstN(count_);
+  }
+  PORTABLE_FORCEINLINE_FUNCTION Simd<int, W> Indices() const {
+    Simd<int, W> out;
+    POC_SIMD_LOOP
+    for (int l = 0; l < W; l++) {
+      out[l] = first_ + l;
+    }
+    return out;
+  }
+
+ private:
+  int first_;
+  int count_;
+};
+
+// Load p[index[0]], ..., p[index[W - 1]], touching only lanes in range
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION Simd<T, W> SimdLoad(const T *p, const SimdIndex<W> &index) {
+  return index.Full() ? Simd<T, W>::Load(p + index.First())
+                      : Simd<T, W>::Load(p + index.First(), index.Mask());
+}
+template <typename T, int W>
+PORTABLE_FORCEINLINE_FUNCTION void SimdStore(T *p, const SimdIndex<W> &index,
+                                             const Simd<std::type_identity_t<T>, W> &x) {
+  if (index.Full()) {
+    x.Store(p + index.First());
+  } else {
+    x.Store(p + index.First(), index.Mask());
+  }
+}
+
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_SIMD_HPP_
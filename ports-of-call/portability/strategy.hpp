@@ -0,0 +1,139 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_STRATEGY_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_STRATEGY_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// The portability strategy, the PORTABLE_* function and lambda
+// decorators it implies, and printf shims callable from device code.
+// Included by both portability.hpp and portable_errors.hpp, so that
+// the error checks can be used throughout portability.hpp.
+
+#include <cstddef>
+#include <cstdio>
+
+#include <ports-of-call/portable_config.hpp>
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+#ifdef PORTABILITY_STRATEGY_CUDA
+#error "Two or more portability strategies defined."
+#endif // PORTABILITY_STRATEGY_CUDA
+#ifdef PORTABILITY_STRATEGY_NONE
+#error "Two or more portability strategies defined."
+#endif // PORTABILITY_STRATEGY_NONE
+#ifdef PORTABILITY_STRATEGY_OPENMP
+#error "Two or more portability strategies defined."
+#endif // PORTABILITY_STRATEGY_OPENMP
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+#ifdef PORTABILITY_STRATEGY_CUDA
+#ifdef PORTABILITY_STRATEGY_NONE
+#error "Two or more portability strategies defined."
+#endif // PORTABILITY_STRATEGY_NONE
+#ifdef PORTABILITY_STRATEGY_OPENMP
+#error "Two or more portability strategies defined."
+#endif // PORTABILITY_STRATEGY_OPENMP
+#endif // PORTABILITY_STRATEGY_CUDA
+
+#ifdef PORTABILITY_STRATEGY_OPENMP
+#ifdef PORTABILITY_STRATEGY_NONE
+#error "Two or more portability strategies defined."
+#endif // PORTABILITY_STRATEGY_NONE
+#endif // PORTABILITY_STRATEGY_OPENMP
+
+// if no portability strategy defined, define none
+#if !(defined PORTABILITY_STRATEGY_CUDA || defined PORTABILITY_STRATEGY_KOKKOS ||        \
+      defined PORTABILITY_STRATEGY_OPENMP)
+#ifndef PORTABILITY_STRATEGY_NONE
+#define PORTABILITY_STRATEGY_NONE
+#endif // none not defined
+#endif
+
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Sort.hpp"
+#define PORTABLE_FUNCTION KOKKOS_FUNCTION
+#define PORTABLE_INLINE_FUNCTION KOKKOS_INLINE_FUNCTION
+#define PORTABLE_FORCEINLINE_FUNCTION KOKKOS_FORCEINLINE_FUNCTION
+#define PORTABLE_LAMBDA KOKKOS_LAMBDA
+#define _WITH_KOKKOS_
+// PORTABLE_FENCE(), PORTABLE_FENCE("label") or PORTABLE_FENCE(instance[, "label"])
+#define PORTABLE_FENCE(...) PortsOfCall::impl::Fence(__VA_ARGS__)
+#else
+#ifdef PORTABILITY_STRATEGY_CUDA
+// currently error out on cuda since its not implemented
+#error "CUDA portability strategy not yet implemented"
+#include "cuda.h"
+#define PORTABLE_FUNCTION __host__ __device__
+#define PORTABLE_INLINE_FUNCTION __host__ __device__ inline
+#define PORTABLE_FORCEINLINE_FUNCTION __host__ __device__ POC_ALWAYS_INLINE
+#define PORTABLE_LAMBDA [=] __host__ __device__
+#define PORTABLE_FENCE(...) cudaDeviceSynchronize()
+#define _WITH_CUDA_
+// It is worth noting here that we will not define
+// _WITH_CUDA_ when we are doing KOKKOS (even with the
+// CUDA backend)  Rely on KOKKOS_HAVE_CUDA in that case
+#elif defined(PORTABILITY_STRATEGY_OPENMP)
+#ifndef _OPENMP
+#error "PORTABILITY_STRATEGY_OPENMP requires compiling with OpenMP enabled"
+#endif // _OPENMP
+#include <atomic>
+#include <omp.h>
+#define PORTABLE_FUNCTION
+#define PORTABLE_INLINE_FUNCTION inline
+#define PORTABLE_FORCEINLINE_FUNCTION POC_ALWAYS_INLINE
+#define PORTABLE_LAMBDA [=]
+// OpenMP worksharing loops end in an implicit barrier, so all that is
+// left is to drain any streams and order memory.
+#define PORTABLE_FENCE(...) PortsOfCall::impl::Fence(__VA_ARGS__)
+#define _WITH_OPENMP_
+#else
+#define PORTABLE_FUNCTION
+#define PORTABLE_INLINE_FUNCTION inline
+#define PORTABLE_FORCEINLINE_FUNCTION POC_ALWAYS_INLINE
+#define PORTABLE_LAMBDA [=]
+#define PORTABLE_FENCE(...) PortsOfCall::impl::Fence(__VA_ARGS__)
+#endif
+#endif
+
+namespace PortsOfCall {
+// portable printf
+#define PORTABLE_MAX_NUM_CHAR (2048)
+template <typename... Ts>
+PORTABLE_INLINE_FUNCTION void printf(char const *const format, Ts... ts) {
+  // disable for hip
+#ifndef __HIPCC__
+  if constexpr (sizeof...(Ts) > 0) {
+    std::printf(format, ts...);
+  } else {
+    std::printf("%s", format);
+  }
+#endif // __HIPCC__
+  return;
+}
+template <typename... Ts>
+PORTABLE_INLINE_FUNCTION void snprintf(char *target, std::size_t size,
+                                       char const *const format, Ts... ts) {
+#ifndef __HIPCC__
+  std::snprintf(target, size, format, ts...);
+#endif // __HIPCC__
+  return;
+}
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_STRATEGY_HPP_
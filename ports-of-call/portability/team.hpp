@@ -0,0 +1,147 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_TEAM_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_TEAM_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Hierarchical parallelism for portableTeamFor. A kernel is launched
+// as a league of teams; inside, work is spread over the team's threads
+// and each thread's vector lanes:
+//
+//   portableTeamFor("zones", nzones, nmat * sizeof(Real),
+//                   PORTABLE_LAMBDA(const PortsOfCall::TeamMember<> &member) {
+//     const int zone = member.league_rank();
+//     Real *frac = PortsOfCall::TeamScratch<Real>(member, nmat);
+//     PortsOfCall::TeamThreadFor(member, 0, nmat, [&](const int m) {
+//       PortsOfCall::ThreadVectorFor(member, 0, ncomp, [&](const int c) {...});
+//     });
+//   });
+//
+// Under Kokkos the member is the TeamPolicy member type and the ranges
+// are TeamThreadRange, ThreadVectorRange and TeamVectorRange. On host
+// backends each team is run by a single thread, so thread ranges are
+// plain loops, vector ranges are SIMD loops and barriers are no-ops.
+// The member exposes the Kokkos names league_rank(), league_size(),
+// team_rank(), team_size() and team_barrier().
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PortsOfCall {
+
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+template <typename E = Kokkos::DefaultExecutionSpace>
+using TeamMember = typename Kokkos::TeamPolicy<E>::member_type;
+#else
+namespace impl {
+class HostTeamMember {
+ public:
+  HostTeamMember(int league_rank, int league_size, void *scratch,
+                 std::size_t scratch_bytes)
+      : league_rank_(league_rank), league_size_(league_size),
+        scratch_(static_cast<char *>(scratch)), scratch_bytes_(scratch_bytes) {}
+
+  int league_rank() const { return league_rank_; }
+  int league_size() const { return league_size_; }
+  int team_rank() const { return 0; }
+  int team_size() const { return 1; }
+  void team_barrier() const {}
+
+  // Bump allocation out of this team's scratch. Returns nullptr once
+  // the space requested at launch is used up, as Kokkos does.
+  void *AllocateScratch(std::size_t bytes, std::size_t alignment) const {
+    const std::size_t start = (scratch_used_ + alignment - 1) / alignment * alignment;
+    if (start + bytes > scratch_bytes_) return nullptr;
+    scratch_used_ = start + bytes;
+    return scratch_ + start;
+  }
+
+ private:
+  int league_rank_;
+  int league_size_;
+  char *scratch_;
+  std::size_t scratch_bytes_;
+  mutable std::size_t scratch_used_ = 0;
+};
+} // namespace impl
+
+// The team handle passed to a portableTeamFor functor. E is accepted
+// for symmetry with Kokkos, where the member type depends on it.
+template <typename E = void>
+using TeamMember = impl::HostTeamMember;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+// Allocate n values of T from the team's scratch space. All threads
+// of a team must make the same sequence of calls, and the pointers are
+// valid until the team finishes.
+template <typename T, typename Member>
+PORTABLE_INLINE_FUNCTION T *TeamScratch(const Member &member, std::size_t n) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  return static_cast<T *>(
+      member.team_scratch(0).get_shmem_aligned(n * sizeof(T), alignof(T)));
+#else
+  return static_cast<T *>(member.AllocateScratch(n * sizeof(T), alignof(T)));
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+// Spread [start, stop) over the threads of the team
+template <typename Member, typename Function>
+PORTABLE_INLINE_FUNCTION void TeamThreadFor(const Member &member, int start, int stop,
+                                            const Function &function) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, start, stop), function);
+#else
+  (void)member;
+  for (int i = start; i < stop; i++) {
+    function(i);
+  }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+// Spread [start, stop) over the vector lanes of the calling thread
+template <typename Member, typename Function>
+PORTABLE_INLINE_FUNCTION void ThreadVectorFor(const Member &member, int start, int stop,
+                                              const Function &function) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, start, stop), function);
+#else
+  (void)member;
+  POC_SIMD_LOOP
+  for (int i = start; i < stop; i++) {
+    function(i);
+  }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+// Spread [start, stop) over both the threads and vector lanes of the team
+template <typename Member, typename Function>
+PORTABLE_INLINE_FUNCTION void TeamVectorFor(const Member &member, int start, int stop,
+                                            const Function &function) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  Kokkos::parallel_for(Kokkos::TeamVectorRange(member, start, stop), function);
+#else
+  (void)member;
+  POC_SIMD_LOOP
+  for (int i = start; i < stop; i++) {
+    function(i);
+  }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_TEAM_HPP_
@@ -0,0 +1,356 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_THREAD_POOL_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_THREAD_POOL_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// A small, persistent, work-stealing thread pool used by the
+// host-parallel execution space when Kokkos is not available. Work is
+// submitted as a fork-join "job" made of independent blocks. Blocks
+// are dealt round-robin onto per-worker deques; a worker pops from the
+// back of its own deque and, when empty, steals from the front of its
+// neighbors'. The thread that submits a job helps execute blocks until
+// the job is complete, so nested submissions from inside a block make
+// progress rather than deadlock.
+//
+// A job of as many blocks as there are threads, the static split used
+// by portableFor, is dealt the same way every time: block 0 to the
+// submitting thread and block b to worker b - 1. With the workers
+// bound to cores (PORTS_OF_CALL_PROC_BIND, see ProcBind) each part of
+// an array but the first is therefore worked on from the same core in
+// every loop, and pages first touched in such a loop stay local to the
+// cores that use them.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif // __linux__
+
+namespace PortsOfCall {
+namespace impl {
+
+class ThreadPool {
+ public:
+  // How threads are bound to the CPUs the process may run on, in the
+  // order the OS numbers them: None leaves them free to migrate, Close
+  // binds thread s to the s-th CPU, and Spread spaces the threads
+  // evenly over all of them (over both sockets of a dual-socket node,
+  // where Close would fill the first socket first). Only the workers,
+  // threads 1 and up, are bound. Thread 0 stands for the thread that
+  // submits work, which is never bound: threads it creates later would
+  // inherit its mask. Only supported on Linux.
+  enum class ProcBind { None, Close, Spread };
+
+  // nthreads counts the calling thread, so a pool of size 1 has no
+  // workers and executes everything inline.
+  explicit ThreadPool(int nthreads = DefaultNumThreads(),
+                      ProcBind bind = DefaultProcBind())
+      : cpus_(AvailableCpus()), bind_(bind) {
+    Start(nthreads);
+  }
+  ~ThreadPool() { Stop(); }
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // The process-wide pool. Created on first use.
+  static ThreadPool &Global() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  // Thread count from PORTS_OF_CALL_NUM_THREADS, falling back to the
+  // hardware concurrency.
+  static int DefaultNumThreads() {
+    if (const char *env = std::getenv("PORTS_OF_CALL_NUM_THREADS")) {
+      const int n = std::atoi(env);
+      if (n > 0) return n;
+    }
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
+  // Binding from PORTS_OF_CALL_PROC_BIND: close (or true) or spread
+  static ProcBind DefaultProcBind() {
+    if (const char *env = std::getenv("PORTS_OF_CALL_PROC_BIND")) {
+      const std::string bind(env);
+      if (bind == "close" || bind == "true") return ProcBind::Close;
+      if (bind == "spread") return ProcBind::Spread;
+    }
+    return ProcBind::None;
+  }
+
+  int NumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  ProcBind GetProcBind() const { return bind_; }
+  // Rebinds the workers. Must not be called while work is in flight.
+  void SetProcBind(ProcBind bind) {
+    bind_ = bind;
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+      Bind(static_cast<int>(i) + 1, workers_[i].native_handle());
+    }
+  }
+
+  // Threads that loops submitted from the calling thread are spread
+  // over: all of them, unless the thread has set a lower limit.
+  int Concurrency() const {
+    const int limit = ConcurrencyLimit();
+    return limit > 0 ? std::min(limit, NumThreads()) : NumThreads();
+  }
+  static int ConcurrencyLimit() { return concurrency_limit_; }
+  // 0 removes the limit
+  static void SetConcurrencyLimit(int nthreads) { concurrency_limit_ = nthreads; }
+
+  // Tear down and restart the workers. Must not be called while work
+  // is in flight.
+  void Resize(int nthreads) {
+    if (nthreads == NumThreads()) return;
+    Stop();
+    Start(nthreads);
+  }
+
+  // Calls function(b) for every block b in [0, nblocks) and returns
+  // once all blocks are done. The first exception thrown by a block is
+  // rethrown on the calling thread.
+  template <typename Function>
+  void ForEachBlock(std::int64_t nblocks, const Function &function) {
+    if (nblocks <= 0) return;
+    if (nblocks == 1 || workers_.empty()) {
+      for (std::int64_t b = 0; b < nblocks; ++b) {
+        function(b);
+      }
+      return;
+    }
+    Job job;
+    job.run = [](const void *f, std::int64_t b) {
+      (*static_cast<const Function *>(f))(b);
+    };
+    job.function = &function;
+    job.pending.store(nblocks, std::memory_order_relaxed);
+    const int nqueues = static_cast<int>(queues_.size());
+    if (self_pool_ == this) {
+      // nested in one of our blocks: start with our own queue
+      for (std::int64_t b = 0; b < nblocks; ++b) {
+        Push((self_id_ + static_cast<int>(b % nqueues)) % nqueues, Task{&job, b});
+      }
+    } else {
+      // the submitting thread takes every block b with b % nthreads == 0
+      // itself, worker w those with b % nthreads == w + 1
+      const int nthreads = nqueues + 1;
+      for (std::int64_t b = 0; b < nblocks; ++b) {
+        if (b % nthreads != 0) Push(static_cast<int>(b % nthreads) - 1, Task{&job, b});
+      }
+      for (std::int64_t b = 0; b < nblocks; b += nthreads) {
+        Execute(Task{&job, b});
+      }
+    }
+    // help out until every block has been claimed and finished
+    while (job.pending.load(std::memory_order_acquire) > 0) {
+      Task task;
+      if (TryPop(self_pool_ == this ? self_id_ : -1, task)) {
+        Execute(task);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    if (job.error) std::rethrow_exception(job.error);
+  }
+
+ private:
+  static inline thread_local int concurrency_limit_ = 0;
+
+  struct Job {
+    void (*run)(const void *, std::int64_t) = nullptr;
+    const void *function = nullptr;
+    std::atomic<std::int64_t> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+  struct Task {
+    Job *job = nullptr;
+    std::int64_t block = 0;
+  };
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void Start(int nthreads) {
+    const int nworkers = std::max(1, nthreads) - 1;
+    stop_ = false;
+    queues_.clear();
+    for (int i = 0; i < nworkers; ++i) {
+      queues_.emplace_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < nworkers; ++i) {
+      workers_.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+    if (bind_ != ProcBind::None) SetProcBind(bind_);
+  }
+
+#ifdef __linux__
+  using NativeHandle = pthread_t;
+
+  // The CPUs in the calling thread's affinity mask, before any binding
+  static std::vector<int> AvailableCpus() {
+    std::vector<int> cpus;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+      for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, &mask)) cpus.push_back(c);
+      }
+    }
+    return cpus;
+  }
+
+  // Binds thread s of the pool to its CPU, or to all available CPUs
+  void Bind(int s, NativeHandle thread) const {
+    if (cpus_.empty()) return;
+    const int ncpus = static_cast<int>(cpus_.size());
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (bind_ == ProcBind::None) {
+      for (const int c : cpus_) {
+        CPU_SET(c, &mask);
+      }
+    } else if (bind_ == ProcBind::Close) {
+      CPU_SET(cpus_[s % ncpus], &mask);
+    } else {
+      const std::int64_t spaced = std::int64_t(s) * ncpus / NumThreads();
+      CPU_SET(cpus_[spaced % ncpus], &mask);
+    }
+    pthread_setaffinity_np(thread, sizeof(mask), &mask);
+  }
+#else
+  using NativeHandle = std::thread::native_handle_type;
+  static std::vector<int> AvailableCpus() { return {}; }
+  void Bind(int, NativeHandle) const {}
+#endif // __linux__
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &w : workers_) {
+      w.join();
+    }
+    workers_.clear();
+  }
+
+  void Push(int q, Task task) {
+    {
+      std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+      queues_[q]->tasks.push_back(task);
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+  }
+
+  // Pop from the back of our own deque first, then steal from the
+  // front of everyone else's. self < 0 means "not one of our workers".
+  bool TryPop(int self, Task &task) {
+    const int nqueues = static_cast<int>(queues_.size());
+    if (self >= 0) {
+      Queue &own = *queues_[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = own.tasks.back();
+        own.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    const int start = (self >= 0) ? self + 1 : 0;
+    for (int k = 0; k < nqueues; ++k) {
+      const int victim = (start + k) % nqueues;
+      if (victim == self) continue;
+      Queue &other = *queues_[victim];
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (!other.tasks.empty()) {
+        task = other.tasks.front();
+        other.tasks.pop_front();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void Execute(const Task &task) {
+    Job &job = *task.job;
+    try {
+      job.run(job.function, task.block);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.error_mutex);
+      if (!job.error) job.error = std::current_exception();
+    }
+    job.pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  void WorkerLoop(int id) {
+    self_pool_ = this;
+    self_id_ = id;
+    while (true) {
+      Task task;
+      if (TryPop(id, task)) {
+        Execute(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this]() {
+        return stop_ || queued_.load(std::memory_order_relaxed) > 0;
+      });
+      if (stop_ && queued_.load(std::memory_order_relaxed) == 0) break;
+    }
+    self_pool_ = nullptr;
+    self_id_ = -1;
+  }
+
+  std::vector<int> cpus_;
+  ProcBind bind_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::int64_t> queued_{0};
+  bool stop_ = false;
+
+  static inline thread_local ThreadPool *self_pool_ = nullptr;
+  static inline thread_local int self_id_ = -1;
+};
+
+} // namespace impl
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_THREAD_POOL_HPP_
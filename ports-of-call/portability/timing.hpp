@@ -0,0 +1,336 @@
+#ifndef _PORTS_OF_CALL_PORTABILITY_TIMING_HPP_
+#define _PORTS_OF_CALL_PORTABILITY_TIMING_HPP_
+
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// Opt-in per-kernel timing, keyed by the name passed to portableFor
+// and friends. Each kernel accumulates its number of calls, total,
+// minimum and maximum wall time, and the number of loop iterations.
+// Timing is off unless enabled with Timing::Enable() or the
+// PORTS_OF_CALL_TIMING environment variable:
+//
+//   PORTS_OF_CALL_TIMING=table   print a table at exit
+//   PORTS_OF_CALL_TIMING=json    print JSON at exit
+//
+// The report goes to stderr, or to PORTS_OF_CALL_TIMING_FILE if set.
+// When disabled, the cost of a launch is a single relaxed atomic load.
+// When enabled, each thread finds a kernel's statistics through a
+// cache keyed by the name, and records with atomics, so
+// launches from different threads and instances do not serialize.
+//
+// Under Kokkos each timed kernel is also a Kokkos Tools region, and
+// launches are not fenced, so an asynchronous kernel is timed from
+// launch to return; Kokkos Tools (e.g. the kernel timer) see the same
+// regions with device-side times. Timing::EnableFencing(), or
+// PORTS_OF_CALL_TIMING_FENCE=1, fences the instance after each launch
+// instead, so the time covers the kernel at the cost of overlap.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace PortsOfCall {
+namespace Timing {
+
+struct KernelStats {
+  std::string name;
+  std::int64_t calls = 0;
+  std::int64_t iterations = 0;
+  double total_seconds = 0;
+  double min_seconds = 0;
+  double max_seconds = 0;
+};
+
+enum class Format { Table, Json };
+
+} // namespace Timing
+
+namespace impl {
+class TimingRegistry {
+ public:
+  // The statistics of one kernel, updated without a lock
+  struct Entry {
+    explicit Entry(std::string_view n) : name(n) {}
+    const std::string name;
+    std::atomic<std::int64_t> calls{0};
+    std::atomic<std::int64_t> iterations{0};
+    std::atomic<std::int64_t> total_ns{0};
+    std::atomic<std::int64_t> min_ns{std::numeric_limits<std::int64_t>::max()};
+    std::atomic<std::int64_t> max_ns{0};
+  };
+
+  static TimingRegistry &Get() {
+    static TimingRegistry registry;
+    return registry;
+  }
+
+  bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void Enable(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+  bool Fencing() const { return fencing_.load(std::memory_order_relaxed); }
+  void EnableFencing(bool on) { fencing_.store(on, std::memory_order_relaxed); }
+
+  // The entry for name. Entries are never removed, so each thread
+  // caches them by name, keyed by the entry's own copy of the text.
+  // Keying by text rather than address also hits for names rebuilt on
+  // every launch, such as those replayed on a stream's thread.
+  Entry &Find(const char *name) {
+    thread_local std::unordered_map<std::string_view, Entry *, Hash, std::equal_to<>>
+        cache;
+    const std::string_view key(name);
+    if (const auto cached = cache.find(key); cached != cache.end()) {
+      return *cached->second;
+    }
+    Entry *entry = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(key);
+      if (it == entries_.end()) {
+        it = entries_.emplace(std::string(key), std::make_unique<Entry>(key)).first;
+      }
+      entry = it->second.get();
+    }
+    cache.emplace(entry->name, entry);
+    return *entry;
+  }
+
+  void Record(Entry &entry, std::int64_t ns, std::int64_t iterations) {
+    entry.calls.fetch_add(1, std::memory_order_relaxed);
+    entry.iterations.fetch_add(iterations, std::memory_order_relaxed);
+    entry.total_ns.fetch_add(ns, std::memory_order_relaxed);
+    std::int64_t seen = entry.min_ns.load(std::memory_order_relaxed);
+    while (ns < seen && !entry.min_ns.compare_exchange_weak(seen, ns)) {
+    }
+    seen = entry.max_ns.load(std::memory_order_relaxed);
+    while (ns > seen && !entry.max_ns.compare_exchange_weak(seen, ns)) {
+    }
+  }
+
+  // Most expensive kernels first
+  std::vector<Timing::KernelStats> Snapshot() const {
+    std::vector<Timing::KernelStats> out;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      out.reserve(entries_.size());
+      for (const auto &[name, e] : entries_) {
+        const std::int64_t calls = e->calls.load(std::memory_order_relaxed);
+        if (calls == 0) continue;
+        out.push_back({name, calls, e->iterations.load(std::memory_order_relaxed),
+                       1e-9 * e->total_ns.load(std::memory_order_relaxed),
+                       1e-9 * e->min_ns.load(std::memory_order_relaxed),
+                       1e-9 * e->max_ns.load(std::memory_order_relaxed)});
+      }
+    }
+    std::sort(out.begin(), out.end(), [](const auto &a, const auto &b) {
+      return a.total_seconds != b.total_seconds ? a.total_seconds > b.total_seconds
+                                                : a.name < b.name;
+    });
+    return out;
+  }
+
+  // Zeroes every entry; the entries stay, since threads cache them
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[name, e] : entries_) {
+      e->calls = 0;
+      e->iterations = 0;
+      e->total_ns = 0;
+      e->min_ns = std::numeric_limits<std::int64_t>::max();
+      e->max_ns = 0;
+    }
+  }
+
+  ~TimingRegistry() {
+    if (!report_at_exit_) return;
+    if (const char *path = std::getenv("PORTS_OF_CALL_TIMING_FILE")) {
+      std::ofstream file(path);
+      Report(file, format_);
+    } else {
+      Report(std::cerr, format_);
+    }
+  }
+
+  void Report(std::ostream &os, Timing::Format format) const {
+    const auto stats = Snapshot();
+    if (format == Timing::Format::Json) {
+      os << "{\"kernels\": [";
+      for (std::size_t k = 0; k < stats.size(); ++k) {
+        const auto &s = stats[k];
+        os << (k == 0 ? "\n" : ",\n") << "  {\"name\": \"" << JsonEscape(s.name)
+           << "\", \"calls\": " << s.calls << ", \"iterations\": " << s.iterations
+           << ", \"total_s\": " << s.total_seconds << ", \"min_s\": " << s.min_seconds
+           << ", \"max_s\": " << s.max_seconds << "}";
+      }
+      os << "\n]}\n";
+      return;
+    }
+    std::size_t width = 6;
+    for (const auto &s : stats) {
+      width = std::max(width, s.name.size());
+    }
+    char line[256];
+    std::snprintf(line, sizeof(line), "%10s %12s %12s %12s %12s %14s\n", "calls",
+                  "total [s]", "mean [s]", "min [s]", "max [s]", "iterations");
+    os << std::string(width, ' ') << " " << line;
+    for (const auto &s : stats) {
+      std::snprintf(line, sizeof(line), "%10lld %12.4e %12.4e %12.4e %12.4e %14lld\n",
+                    static_cast<long long>(s.calls), s.total_seconds,
+                    s.total_seconds / s.calls, s.min_seconds, s.max_seconds,
+                    static_cast<long long>(s.iterations));
+      os << s.name << std::string(width - s.name.size(), ' ') << " " << line;
+    }
+  }
+
+ private:
+  // transparent hashing so lookups by string_view do not allocate
+  struct Hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const {
+      return std::hash<std::string_view>()(s);
+    }
+  };
+
+  TimingRegistry() {
+    if (const char *env = std::getenv("PORTS_OF_CALL_TIMING")) {
+      const std::string_view mode(env);
+      if (mode == "json") {
+        format_ = Timing::Format::Json;
+        report_at_exit_ = true;
+      } else if (mode == "table" || mode == "1") {
+        report_at_exit_ = true;
+      }
+      enabled_ = report_at_exit_;
+    }
+    if (const char *env = std::getenv("PORTS_OF_CALL_TIMING_FENCE")) {
+      fencing_ = std::string_view(env) == "1";
+    }
+  }
+
+  static std::string JsonEscape(std::string_view s) {
+    std::string out;
+    for (const char c : s) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char code[8];
+        std::snprintf(code, sizeof(code), "\\u%04x", c);
+        out += code;
+      } else {
+        out += c;
+      }
+    }
+    return out;
+  }
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> fencing_{false};
+  bool report_at_exit_ = false;
+  Timing::Format format_ = Timing::Format::Table;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<Entry>, Hash, std::equal_to<>> entries_;
+};
+
+// Times the enclosing scope as one call of kernel name. Under Kokkos
+// the instance is fenced first only if fencing was requested, so by
+// default the time covers the launch of an asynchronous kernel.
+template <typename E>
+class KernelTimer {
+ public:
+  KernelTimer(const char *name, [[maybe_unused]] const E &e, std::int64_t iterations)
+      : active_(TimingRegistry::Get().Enabled()) {
+    if (!active_) return;
+    entry_ = &TimingRegistry::Get().Find(name);
+    iterations_ = iterations;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    e_ = &e;
+    Kokkos::Profiling::pushRegion(entry_->name);
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    start_ = std::chrono::steady_clock::now();
+  }
+  ~KernelTimer() {
+    if (!active_) return;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    if (TimingRegistry::Get().Fencing()) e_->fence("PortsOfCall::Timing");
+#endif // PORTABILITY_STRATEGY_KOKKOS
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_);
+    TimingRegistry::Get().Record(*entry_, elapsed.count(), iterations_);
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    Kokkos::Profiling::popRegion();
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  }
+  KernelTimer(const KernelTimer &) = delete;
+  KernelTimer &operator=(const KernelTimer &) = delete;
+
+ private:
+  bool active_;
+  TimingRegistry::Entry *entry_ = nullptr;
+  std::int64_t iterations_ = 0;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  const E *e_ = nullptr;
+#endif // PORTABILITY_STRATEGY_KOKKOS
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Iterations in the index space bounded by start0, stop0, start1, ...
+template <typename... Bounds>
+std::int64_t IterationCount(Bounds... bounds) {
+  const std::int64_t b[] = {static_cast<std::int64_t>(bounds)...};
+  std::int64_t n = 1;
+  for (std::size_t d = 0; d < sizeof...(Bounds); d += 2) {
+    n *= std::max<std::int64_t>(0, b[d + 1] - b[d]);
+  }
+  return n;
+}
+} // namespace impl
+
+namespace Timing {
+inline void Enable(bool on = true) { impl::TimingRegistry::Get().Enable(on); }
+inline bool Enabled() { return impl::TimingRegistry::Get().Enabled(); }
+// Under Kokkos, fence after each timed launch so the time covers the
+// kernel rather than its launch. No effect on other backends, whose
+// launches return when the kernel is done or run on a stream.
+inline void EnableFencing(bool on = true) {
+  impl::TimingRegistry::Get().EnableFencing(on);
+}
+// Forget everything recorded so far
+inline void Reset() { impl::TimingRegistry::Get().Reset(); }
+// Per-kernel statistics, most expensive first
+inline std::vector<KernelStats> Snapshot() {
+  return impl::TimingRegistry::Get().Snapshot();
+}
+inline void Report(std::ostream &os, Format format = Format::Table) {
+  impl::TimingRegistry::Get().Report(os, format);
+}
+} // namespace Timing
+} // namespace PortsOfCall
+
+#endif // _PORTS_OF_CALL_PORTABILITY_TIMING_HPP_
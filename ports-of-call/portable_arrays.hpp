@@ -23,11 +23,14 @@
 //  The operator() is overloaded, e.g. elements of a 4D array of size
 //  [N4xN3xN2xN1] are accessed as:  A(n,k,j,i) = A[i + N1*(j + N2*(k + N3*n))]
 //  NOTE THE TRAILING INDEX INSIDE THE PARENTHESES IS INDEXED FASTEST
+//  Extents and flat offsets are 64-bit, so an array may hold more than
+//  2^31 elements while each index passed to operator() stays an int.
 
 #include "portability.hpp"
 #include <algorithm>
 #include <assert.h>
 #include <cstddef> // size_t
+#include <cstdint> // int64_t
 #include <cstring> // memset()
 #include <utility> // swap()
 
@@ -35,28 +38,32 @@ template <typename T>
 class PortableMDArray {
  public:
   static constexpr int MAXDIM = 6;
+  using index_type = std::int64_t;
 
   // ctors
   // default ctor: simply set null PortableMDArray
   PORTABLE_FUNCTION
   PortableMDArray() noexcept
       : pdata_(nullptr), nx1_(0), nx2_(0), nx3_(0), nx4_(0), nx5_(0), nx6_(0) {}
-  PORTABLE_FUNCTION PortableMDArray(T *data, int nx1) noexcept
+  PORTABLE_FUNCTION PortableMDArray(T *data, index_type nx1) noexcept
       : pdata_(data), nx1_(nx1), nx2_(1), nx3_(1), nx4_(1), nx5_(1), nx6_(1) {}
   PORTABLE_FUNCTION
-  PortableMDArray(T *data, int nx2, int nx1) noexcept
+  PortableMDArray(T *data, index_type nx2, index_type nx1) noexcept
       : pdata_(data), nx1_(nx1), nx2_(nx2), nx3_(1), nx4_(1), nx5_(1), nx6_(1) {}
   PORTABLE_FUNCTION
-  PortableMDArray(T *data, int nx3, int nx2, int nx1) noexcept
+  PortableMDArray(T *data, index_type nx3, index_type nx2, index_type nx1) noexcept
       : pdata_(data), nx1_(nx1), nx2_(nx2), nx3_(nx3), nx4_(1), nx5_(1), nx6_(1) {}
   PORTABLE_FUNCTION
-  PortableMDArray(T *data, int nx4, int nx3, int nx2, int nx1) noexcept
+  PortableMDArray(T *data, index_type nx4, index_type nx3, index_type nx2,
+                  index_type nx1) noexcept
       : pdata_(data), nx1_(nx1), nx2_(nx2), nx3_(nx3), nx4_(nx4), nx5_(1), nx6_(1) {}
   PORTABLE_FUNCTION
-  PortableMDArray(T *data, int nx5, int nx4, int nx3, int nx2, int nx1) noexcept
+  PortableMDArray(T *data, index_type nx5, index_type nx4, index_type nx3, index_type nx2,
+                  index_type nx1) noexcept
       : pdata_(data), nx1_(nx1), nx2_(nx2), nx3_(nx3), nx4_(nx4), nx5_(nx5), nx6_(1) {}
   PORTABLE_FUNCTION
-  PortableMDArray(T *data, int nx6, int nx5, int nx4, int nx3, int nx2, int nx1) noexcept
+  PortableMDArray(T *data, index_type nx6, index_type nx5, index_type nx4, index_type nx3,
+                  index_type nx2, index_type nx1) noexcept
       : pdata_(data), nx1_(nx1), nx2_(nx2), nx3_(nx3), nx4_(nx4), nx5_(nx5), nx6_(nx6) {}
 
   // define copy constructor and overload assignment operator so both do deep
@@ -65,28 +72,32 @@ class PortableMDArray {
   PortableMDArray<T> &operator=(const PortableMDArray<T> &t) noexcept;
 
   // public functions to allocate/deallocate memory for 1D-5D data
-  PORTABLE_FUNCTION void NewPortableMDArray(T *data, int nx1) noexcept;
-  PORTABLE_FUNCTION void NewPortableMDArray(T *data, int nx2, int nx1) noexcept;
-  PORTABLE_FUNCTION void NewPortableMDArray(T *data, int nx3, int nx2, int nx1) noexcept;
-  PORTABLE_FUNCTION void NewPortableMDArray(T *data, int nx4, int nx3, int nx2,
-                                            int nx1) noexcept;
-  PORTABLE_FUNCTION void NewPortableMDArray(T *data, int nx5, int nx4, int nx3, int nx2,
-                                            int nx1) noexcept;
-  PORTABLE_FUNCTION void NewPortableMDArray(T *data, int nx6, int nx5, int nx4, int nx3,
-                                            int nx2, int nx1) noexcept;
+  PORTABLE_FUNCTION void NewPortableMDArray(T *data, index_type nx1) noexcept;
+  PORTABLE_FUNCTION void NewPortableMDArray(T *data, index_type nx2,
+                                            index_type nx1) noexcept;
+  PORTABLE_FUNCTION void NewPortableMDArray(T *data, index_type nx3, index_type nx2,
+                                            index_type nx1) noexcept;
+  PORTABLE_FUNCTION void NewPortableMDArray(T *data, index_type nx4, index_type nx3,
+                                            index_type nx2, index_type nx1) noexcept;
+  PORTABLE_FUNCTION void NewPortableMDArray(T *data, index_type nx5, index_type nx4,
+                                            index_type nx3, index_type nx2,
+                                            index_type nx1) noexcept;
+  PORTABLE_FUNCTION void NewPortableMDArray(T *data, index_type nx6, index_type nx5,
+                                            index_type nx4, index_type nx3,
+                                            index_type nx2, index_type nx1) noexcept;
 
   // public function to swap underlying data pointers of two equally-sized
   // arrays
   void SwapPortableMDArray(PortableMDArray<T> &array2);
 
   // functions to get array dimensions
-  PORTABLE_FORCEINLINE_FUNCTION int GetDim1() const { return nx1_; }
-  PORTABLE_FORCEINLINE_FUNCTION int GetDim2() const { return nx2_; }
-  PORTABLE_FORCEINLINE_FUNCTION int GetDim3() const { return nx3_; }
-  PORTABLE_FORCEINLINE_FUNCTION int GetDim4() const { return nx4_; }
-  PORTABLE_FORCEINLINE_FUNCTION int GetDim5() const { return nx5_; }
-  PORTABLE_FORCEINLINE_FUNCTION int GetDim6() const { return nx6_; }
-  PORTABLE_INLINE_FUNCTION int GetDim(size_t i) const {
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetDim1() const { return nx1_; }
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetDim2() const { return nx2_; }
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetDim3() const { return nx3_; }
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetDim4() const { return nx4_; }
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetDim5() const { return nx5_; }
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetDim6() const { return nx6_; }
+  PORTABLE_INLINE_FUNCTION index_type GetDim(size_t i) const {
     // TODO: remove if performance cirtical
     assert(0 < i && i <= 6 && "PortableMDArrays are max 6D");
     switch (i) {
@@ -107,11 +118,11 @@ class PortableMDArray {
   }
 
   // a function to get the total size of the array
-  PORTABLE_FORCEINLINE_FUNCTION int GetSize() const {
+  PORTABLE_FORCEINLINE_FUNCTION index_type GetSize() const {
     return nx1_ * nx2_ * nx3_ * nx4_ * nx5_ * nx6_;
   }
   PORTABLE_FORCEINLINE_FUNCTION std::size_t GetSizeInBytes() const {
-    return nx1_ * nx2_ * nx3_ * nx4_ * nx5_ * nx6_ * sizeof(T);
+    return static_cast<std::size_t>(GetSize()) * sizeof(T);
   }
 
   PORTABLE_INLINE_FUNCTION size_t GetRank() const {
@@ -121,8 +132,8 @@ class PortableMDArray {
     return 0;
   }
 
-  PORTABLE_INLINE_FUNCTION void Reshape(int nx6, int nx5, int nx4, int nx3, int nx2,
-                                        int nx1) {
+  PORTABLE_INLINE_FUNCTION void Reshape(index_type nx6, index_type nx5, index_type nx4,
+                                        index_type nx3, index_type nx2, index_type nx1) {
     assert(nx6 * nx5 * nx4 * nx3 * nx2 * nx1 == GetSize());
     nx1_ = nx1;
     nx2_ = nx2;
@@ -131,19 +142,21 @@ class PortableMDArray {
     nx5_ = nx5;
     nx6_ = nx6;
   }
-  PORTABLE_INLINE_FUNCTION void Reshape(int nx5, int nx4, int nx3, int nx2, int nx1) {
+  PORTABLE_INLINE_FUNCTION void Reshape(index_type nx5, index_type nx4, index_type nx3,
+                                        index_type nx2, index_type nx1) {
     Reshape(1, nx5, nx4, nx3, nx2, nx1);
   }
-  PORTABLE_INLINE_FUNCTION void Reshape(int nx4, int nx3, int nx2, int nx1) {
+  PORTABLE_INLINE_FUNCTION void Reshape(index_type nx4, index_type nx3, index_type nx2,
+                                        index_type nx1) {
     Reshape(1, 1, nx4, nx3, nx2, nx1);
   }
-  PORTABLE_INLINE_FUNCTION void Reshape(int nx3, int nx2, int nx1) {
+  PORTABLE_INLINE_FUNCTION void Reshape(index_type nx3, index_type nx2, index_type nx1) {
     Reshape(1, 1, 1, nx3, nx2, nx1);
   }
-  PORTABLE_INLINE_FUNCTION void Reshape(int nx2, int nx1) {
+  PORTABLE_INLINE_FUNCTION void Reshape(index_type nx2, index_type nx1) {
     Reshape(1, 1, 1, 1, nx2, nx1);
   }
-  PORTABLE_INLINE_FUNCTION void Reshape(int nx1) { Reshape(1, 1, 1, 1, 1, nx1); }
+  PORTABLE_INLINE_FUNCTION void Reshape(index_type nx1) { Reshape(1, 1, 1, 1, 1, nx1); }
 
   PORTABLE_FORCEINLINE_FUNCTION bool IsShallowSlice() { return true; }
   PORTABLE_FORCEINLINE_FUNCTION bool IsEmpty() { return GetSize() < 1; }
@@ -158,10 +171,10 @@ class PortableMDArray {
   PORTABLE_FORCEINLINE_FUNCTION T *end() { return pdata_ + GetSize(); }
 
   // 1D accessors intended for accessing flattened data
-  PORTABLE_FORCEINLINE_FUNCTION const T &operator[](const int n) const {
+  PORTABLE_FORCEINLINE_FUNCTION const T &operator[](const index_type n) const {
     return pdata_[n];
   }
-  PORTABLE_FORCEINLINE_FUNCTION T &operator[](const int n) { return pdata_[n]; }
+  PORTABLE_FORCEINLINE_FUNCTION T &operator[](const index_type n) { return pdata_[n]; }
 
   // overload "function call" operator() to access 1d-5d data
   // provides Fortran-like syntax for multidimensional arrays vs. "subscript"
@@ -172,12 +185,14 @@ class PortableMDArray {
   // e.g.: a(3) = 3.0;
   PORTABLE_FORCEINLINE_FUNCTION T &operator()() { return pdata_[0]; }
 
-  PORTABLE_FORCEINLINE_FUNCTION T &operator()(const int n) { return pdata_[n]; }
+  PORTABLE_FORCEINLINE_FUNCTION T &operator()(const index_type n) { return pdata_[n]; }
   // "const variants" called for "const PortableMDArray<T>" returns T by value,
   // since T is typically a built-in type (versus "const T &" to avoid copying
   // for general types)
   PORTABLE_FORCEINLINE_FUNCTION T &operator()() const { return pdata_[0]; }
-  PORTABLE_FORCEINLINE_FUNCTION T &operator()(const int n) const { return pdata_[n]; }
+  PORTABLE_FORCEINLINE_FUNCTION T &operator()(const index_type n) const {
+    return pdata_[n];
+  }
   PORTABLE_FORCEINLINE_FUNCTION T &operator()(const int n, const int i) {
     return pdata_[i + nx1_ * n];
   }
@@ -243,12 +258,12 @@ class PortableMDArray {
 
   // (deferred) initialize an array with slice from another array
   PORTABLE_FUNCTION
-  void InitWithShallowSlice(const PortableMDArray<T> &src, const int dim, const int indx,
-                            const int nvar);
+  void InitWithShallowSlice(const PortableMDArray<T> &src, const int dim,
+                            const index_type indx, const index_type nvar);
 
  private:
   T *pdata_;
-  int nx1_, nx2_, nx3_, nx4_, nx5_, nx6_;
+  index_type nx1_, nx2_, nx3_, nx4_, nx5_, nx6_;
 };
 
 // copy constructor (does a shallow copy)
@@ -301,7 +316,7 @@ bool PortableMDArray<T>::operator==(const PortableMDArray<T> &rhs) const {
 template <typename T>
 PORTABLE_FUNCTION void
 PortableMDArray<T>::InitWithShallowSlice(const PortableMDArray<T> &src, const int dim,
-                                         const int indx, const int nvar) {
+                                         const index_type indx, const index_type nvar) {
   pdata_ = src.pdata_;
   if (dim == 6) {
     nx6_ = nvar;
@@ -360,7 +375,8 @@ PortableMDArray<T>::InitWithShallowSlice(const PortableMDArray<T> &src, const in
 //  \brief allocate new 1D array with elements initialized to zero.
 
 template <typename T>
-PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx1) noexcept {
+PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data,
+                                                              index_type nx1) noexcept {
   nx1_ = nx1;
   nx2_ = 1;
   nx3_ = 1;
@@ -375,8 +391,8 @@ PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx1)
 //  \brief 2d data allocation
 
 template <typename T>
-PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx2,
-                                                              int nx1) noexcept {
+PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, index_type nx2,
+                                                              index_type nx1) noexcept {
   nx1_ = nx1;
   nx2_ = nx2;
   nx3_ = 1;
@@ -391,8 +407,9 @@ PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx2,
 //  \brief 3d data allocation
 
 template <typename T>
-PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx3, int nx2,
-                                                              int nx1) noexcept {
+PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, index_type nx3,
+                                                              index_type nx2,
+                                                              index_type nx1) noexcept {
   nx1_ = nx1;
   nx2_ = nx2;
   nx3_ = nx3;
@@ -407,8 +424,10 @@ PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx3,
 //  \brief 4d data allocation
 
 template <typename T>
-PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx4, int nx3,
-                                                              int nx2, int nx1) noexcept {
+PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, index_type nx4,
+                                                              index_type nx3,
+                                                              index_type nx2,
+                                                              index_type nx1) noexcept {
   nx1_ = nx1;
   nx2_ = nx2;
   nx3_ = nx3;
@@ -423,9 +442,11 @@ PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx4,
 //  \brief 5d data allocation
 
 template <typename T>
-PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx5, int nx4,
-                                                              int nx3, int nx2,
-                                                              int nx1) noexcept {
+PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, index_type nx5,
+                                                              index_type nx4,
+                                                              index_type nx3,
+                                                              index_type nx2,
+                                                              index_type nx1) noexcept {
   nx1_ = nx1;
   nx2_ = nx2;
   nx3_ = nx3;
@@ -440,9 +461,12 @@ PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx5,
 //  \brief 6d data allocation
 
 template <typename T>
-PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, int nx6, int nx5,
-                                                              int nx4, int nx3, int nx2,
-                                                              int nx1) noexcept {
+PORTABLE_FUNCTION void PortableMDArray<T>::NewPortableMDArray(T *data, index_type nx6,
+                                                              index_type nx5,
+                                                              index_type nx4,
+                                                              index_type nx3,
+                                                              index_type nx2,
+                                                              index_type nx1) noexcept {
   nx1_ = nx1;
   nx2_ = nx2;
   nx3_ = nx3;
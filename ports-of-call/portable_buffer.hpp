@@ -0,0 +1,339 @@
+#ifndef _PORTABLE_BUFFER_HPP_
+#define _PORTABLE_BUFFER_HPP_
+// ========================================================================================
+// © (or copyright) 2026. Triad National Security, LLC. All rights
+// reserved.  This program was produced under U.S. Government contract
+// 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is
+// operated by Triad National Security, LLC for the U.S.  Department of
+// Energy/National Nuclear Security Administration. All rights in the
+// program are reserved by Triad National Security, LLC, and the
+// U.S. Department of Energy/National Nuclear Security
+// Administration. The Government is granted for itself and others acting
+// on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+// in this material to reproduce, prepare derivative works, distribute
+// copies to the public, perform publicly and display publicly, and to
+// permit others to do so.
+// ========================================================================================
+
+// This file was generated in part with generative AI
+
+// PortableBuffer<T, Space> owns size() elements of T allocated with
+// portableMalloc on Space and frees them with portableFree. It can be
+// moved but not copied; only mirrors share its memory:
+//
+//   PortableBuffer<Real> rho(nz * ny * nx);
+//   auto r = rho.view(nz, ny, nx);  // a PortableMDArray onto it
+//   portableFor("init", 0, nz, 0, ny, 0, nx,
+//               PORTABLE_LAMBDA(int k, int j, int i) { r(k, j, i) = 1; });
+//   auto h = rho.mirror<PortsOfCall::Exec::Host>();
+//
+// mirror<OtherSpace>() gives the contents in OtherSpace. When both
+// spaces allocate the same memory, as every space does when execution
+// is on the host, nothing is copied and the mirror shares the memory,
+// like Kokkos::create_mirror_view: it stays valid after the source is
+// gone, just as a copy would on a GPU.
+//
+// PortableDualBuffer<T> pairs a buffer on Exec::Device with one on
+// Exec::Host and tracks which side was modified since the last sync,
+// so that sync<Space>() transfers only when the other side has changes:
+//
+//   PortableDualBuffer<Real> rho(n);
+//   fill(rho.view<Host>()); rho.modify<Host>();
+//   rho.sync<Device>();  // copies to the device
+//   rho.sync<Device>();  // elided, nothing changed
+//
+// When execution is on the host the two sides are the same memory and
+// every sync is elided.
+
+#include "portability.hpp"
+#include "portable_arrays.hpp"
+#include "portable_errors.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace PortsOfCall {
+namespace impl {
+// True if memory allocated on spaces A and B is the same memory
+template <typename A, typename B>
+constexpr bool spaces_alias_v = std::is_same_v<memory_space_t<A>, memory_space_t<B>>;
+
+// Copies size_bytes from memory in space From to memory in space To
+template <typename To, typename From, typename T>
+void CopyBetween(T *const to, const T *const from, const std::size_t size_bytes) {
+  if (size_bytes == 0 || to == from) return;
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+  const std::size_t length = size_bytes / sizeof(T);
+  using UM = Kokkos::MemoryUnmanaged;
+  Kokkos::View<const T *, memory_space_t<From>, UM> from_v(from, length);
+  Kokkos::View<T *, memory_space_t<To>, UM> to_v(to, length);
+  Kokkos::deep_copy(to_v, from_v);
+#elif defined(PORTABILITY_STRATEGY_CUDA)
+  cudaMemcpy(to, from, size_bytes, cudaMemcpyDefault);
+#else
+  std::copy(from, from + size_bytes / sizeof(T), to);
+#endif // PORTABILITY_STRATEGY_KOKKOS
+}
+} // namespace impl
+
+// Bytes transferred by PortableDualBuffer syncs and bytes not
+// transferred because the other side was current or the same memory
+struct DualSyncStats {
+  std::size_t syncs = 0;
+  std::size_t bytes_moved = 0;
+  std::size_t bytes_elided = 0;
+};
+
+namespace impl {
+struct DualSyncCounters {
+  std::atomic<std::size_t> syncs{0};
+  std::atomic<std::size_t> bytes_moved{0};
+  std::atomic<std::size_t> bytes_elided{0};
+};
+inline DualSyncCounters &GlobalDualSyncCounters() {
+  static DualSyncCounters counters;
+  return counters;
+}
+} // namespace impl
+
+// Totals over every PortableDualBuffer in the program
+inline DualSyncStats DualSyncTotals() {
+  const auto &c = impl::GlobalDualSyncCounters();
+  return {c.syncs.load(std::memory_order_relaxed),
+          c.bytes_moved.load(std::memory_order_relaxed),
+          c.bytes_elided.load(std::memory_order_relaxed)};
+}
+inline void ResetDualSyncTotals() {
+  auto &c = impl::GlobalDualSyncCounters();
+  c.syncs = 0;
+  c.bytes_moved = 0;
+  c.bytes_elided = 0;
+}
+} // namespace PortsOfCall
+
+template <typename T, typename Space = PortsOfCall::Exec::Device>
+class PortableBuffer {
+ public:
+  using value_type = T;
+  using space = Space;
+  using index_type = typename PortableMDArray<T>::index_type;
+
+  PortableBuffer() = default;
+  explicit PortableBuffer(std::size_t size,
+                          const PortsOfCall::MallocOptions &options = {})
+      : size_(size) {
+    if (size > 0) {
+      T *const data = static_cast<T *>(
+          PortsOfCall::portableMalloc(Space(), size * sizeof(T), options));
+      PORTABLE_ALWAYS_REQUIRE(data != nullptr, "PortableBuffer allocation failed");
+      data_.reset(data, Deleter(&Free));
+    }
+  }
+
+  PortableBuffer(const PortableBuffer &) = delete;
+  PortableBuffer &operator=(const PortableBuffer &) = delete;
+  PortableBuffer(PortableBuffer &&other) noexcept
+      : data_(std::move(other.data_)), size_(std::exchange(other.size_, 0)) {}
+  PortableBuffer &operator=(PortableBuffer &&other) noexcept {
+    if (this != &other) {
+      data_ = std::move(other.data_);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  T *data() const { return data_.get(); }
+  std::size_t size() const { return size_; }
+  std::size_t bytes() const { return size_ * sizeof(T); }
+  bool empty() const { return size_ == 0; }
+  // The number of buffers sharing the memory, more than one after an
+  // aliasing mirror
+  long use_count() const { return data_.use_count(); }
+
+  // Lets go of the memory, which is freed once no mirror shares it,
+  // leaving the buffer empty
+  void reset() {
+    data_.reset();
+    size_ = 0;
+  }
+  // Gives up ownership of the memory, which the caller must
+  // portableFree on Space. The memory must not be shared.
+  T *release() {
+    if (data_ == nullptr) return nullptr;
+    PORTABLE_ALWAYS_REQUIRE(data_.use_count() == 1,
+                            "cannot release memory shared with a mirror");
+    T *const data = data_.get();
+    // the deleter is kept, so forget the memory before dropping it
+    *std::get_deleter<Deleter>(data_) = [](T *) {};
+    reset();
+    return data;
+  }
+
+  // A PortableMDArray onto the buffer, slowest extent first, by
+  // default one-dimensional over all of it. The extents must cover
+  // the buffer exactly.
+  template <typename... Extents>
+  PortableMDArray<T> view(const Extents... extents) const {
+    static_assert(sizeof...(Extents) <= PortableMDArray<T>::MAXDIM,
+                  "PortableMDArrays are at most 6D");
+    if constexpr (sizeof...(Extents) == 0) {
+      return PortableMDArray<T>(data(), static_cast<index_type>(size_));
+    } else {
+      PORTABLE_ALWAYS_REQUIRE((static_cast<std::size_t>(extents) * ...) == size_,
+                              "view extents must match the buffer size");
+      return PortableMDArray<T>(data(), static_cast<index_type>(extents)...);
+    }
+  }
+
+  // The contents in OtherSpace, copied only if OtherSpace allocates
+  // different memory than Space. Otherwise the mirror shares the
+  // memory with this buffer, which is freed when the last of them goes,
+  // so a mirror may outlive its source on every backend.
+  template <typename OtherSpace>
+  PortableBuffer<T, OtherSpace> mirror() const & {
+    if constexpr (PortsOfCall::impl::spaces_alias_v<Space, OtherSpace>) {
+      return PortableBuffer<T, OtherSpace>(data_, size_);
+    } else {
+      return Copy<OtherSpace>();
+    }
+  }
+  template <typename OtherSpace>
+  PortableBuffer<T, OtherSpace> mirror() && {
+    if constexpr (PortsOfCall::impl::spaces_alias_v<Space, OtherSpace>) {
+      return PortableBuffer<T, OtherSpace>(std::move(data_),
+                                           std::exchange(size_, 0));
+    } else {
+      return Copy<OtherSpace>();
+    }
+  }
+
+  // A copy of the contents in OtherSpace, always in new memory
+  template <typename OtherSpace = Space>
+  PortableBuffer<T, OtherSpace> clone() const {
+    return Copy<OtherSpace>();
+  }
+
+ private:
+  template <typename, typename>
+  friend class PortableBuffer;
+  using Deleter = void (*)(T *);
+  static void Free(T *p) { PortsOfCall::portableFree(Space(), p); }
+
+  PortableBuffer(std::shared_ptr<T> data, std::size_t size)
+      : data_(std::move(data)), size_(size) {}
+
+  template <typename OtherSpace>
+  PortableBuffer<T, OtherSpace> Copy() const {
+    PortableBuffer<T, OtherSpace> copy(size_);
+    PortsOfCall::impl::CopyBetween<OtherSpace, Space>(copy.data(), data(), bytes());
+    return copy;
+  }
+
+  // freed with portableFree on the space it was allocated in
+  std::shared_ptr<T> data_;
+  std::size_t size_ = 0;
+};
+
+template <typename T>
+class PortableDualBuffer {
+  using Device = PortsOfCall::Exec::Device;
+  using Host = PortsOfCall::Exec::Host;
+
+ public:
+  using value_type = T;
+  // True if the host side is the device memory, so nothing is ever
+  // transferred
+  static constexpr bool aliased =
+      PortsOfCall::EXECUTION_IS_HOST || PortsOfCall::impl::spaces_alias_v<Device, Host>;
+
+  PortableDualBuffer() = default;
+  explicit PortableDualBuffer(std::size_t size,
+                              const PortsOfCall::MallocOptions &options = {})
+      : device_(size, options) {
+    if constexpr (!aliased) host_ = PortableBuffer<T, Host>(size);
+  }
+
+  std::size_t size() const { return device_.size(); }
+  std::size_t bytes() const { return device_.bytes(); }
+  bool empty() const { return device_.empty(); }
+
+  // The memory of the side Space runs on, Exec::Device or a host space
+  template <typename Space>
+  T *data() const {
+    if constexpr (aliased || IsDevice<Space>()) {
+      return device_.data();
+    } else {
+      return host_.data();
+    }
+  }
+  template <typename Space, typename... Extents>
+  PortableMDArray<T> view(const Extents... extents) const {
+    if constexpr (aliased || IsDevice<Space>()) {
+      return device_.view(extents...);
+    } else {
+      return host_.view(extents...);
+    }
+  }
+
+  // Records that the Space side was written. Modifying both sides
+  // without a sync in between is an error, since one set of changes
+  // would be lost.
+  template <typename Space>
+  void modify() {
+    if constexpr (!aliased) {
+      PORTABLE_ALWAYS_REQUIRE(!modified_[!IsDevice<Space>()],
+                              "PortableDualBuffer modified on both sides");
+      modified_[IsDevice<Space>()] = true;
+    }
+  }
+  // True if the other side has changes that the Space side lacks
+  template <typename Space>
+  bool need_sync() const {
+    return !aliased && modified_[!IsDevice<Space>()];
+  }
+  // Brings the Space side up to date, transferring only if needed
+  template <typename Space>
+  void sync() {
+    auto &global = PortsOfCall::impl::GlobalDualSyncCounters();
+    stats_.syncs++;
+    global.syncs.fetch_add(1, std::memory_order_relaxed);
+    if (!need_sync<Space>()) {
+      stats_.bytes_elided += bytes();
+      global.bytes_elided.fetch_add(bytes(), std::memory_order_relaxed);
+      return;
+    }
+    if constexpr (IsDevice<Space>()) {
+      PortsOfCall::impl::CopyBetween<Device, Host>(device_.data(), host_.data(), bytes());
+    } else {
+      PortsOfCall::impl::CopyBetween<Host, Device>(host_.data(), device_.data(), bytes());
+    }
+    modified_[!IsDevice<Space>()] = false;
+    stats_.bytes_moved += bytes();
+    global.bytes_moved.fetch_add(bytes(), std::memory_order_relaxed);
+  }
+  // Drops any pending changes, e.g. after the whole buffer is
+  // overwritten on both sides
+  void clear_sync_state() { modified_[0] = modified_[1] = false; }
+
+  const PortsOfCall::DualSyncStats &stats() const { return stats_; }
+  void reset_stats() { stats_ = {}; }
+
+ private:
+  template <typename Space>
+  static constexpr bool IsDevice() {
+    return PortsOfCall::impl::spaces_alias_v<Space, Device>;
+  }
+
+  PortableBuffer<T, Device> device_;
+  PortableBuffer<T, Host> host_;
+  // modified_[1]: device side changed since the last sync, [0]: host side
+  bool modified_[2] = {false, false};
+  PortsOfCall::DualSyncStats stats_;
+};
+
+#endif // _PORTABLE_BUFFER_HPP_
@@ -49,6 +49,18 @@
 #define POC_ALWAYS_INLINE inline
 #endif
 
+// Asks the compiler to vectorize the loop that follows, ignoring
+// assumed dependencies. Only meaningful on host.
+#if defined(_OPENMP)
+#define POC_SIMD_LOOP _Pragma("omp simd")
+#elif defined(__clang__)
+#define POC_SIMD_LOOP _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define POC_SIMD_LOOP _Pragma("GCC ivdep")
+#else
+#define POC_SIMD_LOOP
+#endif
+
 #if __has_builtin(__builtin_addressof) || (defined(__GNUC__) && __GNUC__ >= 7) ||        \
     defined(_MSC_VER)
 #define PORTABLE_HAS_BUILTIN_ADDRESSOF
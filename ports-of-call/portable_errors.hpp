@@ -25,8 +25,7 @@
 #include <cstdio>
 #include <cstdlib>
 
-// TODO(JMM): Is relative path right here?
-#include "portability.hpp"
+#include <ports-of-call/portability/strategy.hpp>
 
 // Use these macros for error handling. A macro is required, as
 // opposed to a function, so that the file name and line number can be
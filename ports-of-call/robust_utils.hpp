@@ -103,6 +103,13 @@ PORTABLE_FORCEINLINE_FUNCTION auto ratio(const A &a, const B &b) {
   return a / denom;
 }
 
+// Lane by lane when either argument is a SIMD pack
+template <typename A, typename B>
+  requires(is_simd_v<A> || is_simd_v<B>)
+PORTABLE_FORCEINLINE_FUNCTION auto ratio(const A &a, const B &b) {
+  return SimdMap([](const auto x, const auto y) { return ratio(x, y); }, a, b);
+}
+
 template <typename T>
 PORTABLE_FORCEINLINE_FUNCTION T safe_arg_exp(const T &x) {
   return x < min_exp_arg<T>()   ? 0.0
@@ -63,6 +63,17 @@ TEST_CASE("power", "[math_utils]") {
   CHECK_THAT(power(-3.0, 3.0), WithinRel(std::pow(-3.0, 3.0)));
   CHECK_THAT(power(-3, -3.0), WithinRel(std::pow(-3, -3.0)));
   CHECK_THAT(power(-3.0, -3.0), WithinRel(std::pow(-3.0, -3.0)));
+  // SIMD packs, lane by lane
+  PortsOfCall::Simd<double, 4> x(0.0);
+  for (int l = 0; l < 4; ++l) {
+    x[l] = 1.5 + l;
+  }
+  const auto cubed = power(x, 3);
+  const auto root = power(x, 0.5);
+  for (int l = 0; l < 4; ++l) {
+    CHECK_THAT(cubed[l], WithinRel(power(1.5 + l, 3)));
+    CHECK_THAT(root[l], WithinRel(std::sqrt(1.5 + l)));
+  }
 }
 
 TEST_CASE("expm1", "[math_utils]") {
@@ -15,6 +15,15 @@
 
 #include <ports-of-call/portability.hpp>
 #include <ports-of-call/portable_arrays.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 #ifndef CATCH_CONFIG_FAST_COMPILE
@@ -242,3 +251,1661 @@ TEST_CASE("portableFor and portableReduce accept an explicit execution-space sel
     PORTABLE_FREE(values_ptr);
   }
 }
+
+TEST_CASE("HostParallel execution matches serial host execution",
+          "[portableFor][portableReduce][HostParallel]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  // force several workers even on a single-core machine
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  using PortsOfCall::Exec::HostParallel;
+  constexpr int NB = 2, NA = 3, NZ = 5, NY = 7, NX = 11;
+  constexpr int N = NB * NA * NZ * NY * NX;
+  std::vector<int> values(N, 0);
+  int *const v = values.data();
+
+  SECTION("1D loops visit every index exactly once") {
+    portableFor(
+        "1D host parallel", HostParallel(), 0, N,
+        PORTABLE_LAMBDA(const int i) { v[i] += i; });
+    int nwrong = 0;
+    for (int i = 0; i < N; ++i) {
+      nwrong += (values[i] != i);
+    }
+    REQUIRE(nwrong == 0);
+  }
+
+  SECTION("3D loops visit every index exactly once") {
+    portableFor(
+        "3D host parallel", HostParallel(), 0, NZ, 1, NY, 2, NX,
+        PORTABLE_LAMBDA(const int k, const int j, const int i) {
+          v[i + NX * (j + NY * k)] += 1;
+        });
+    int nwrong = 0;
+    for (int k = 0; k < NZ; ++k) {
+      for (int j = 0; j < NY; ++j) {
+        for (int i = 0; i < NX; ++i) {
+          const int expected = (j >= 1 && i >= 2) ? 1 : 0;
+          nwrong += (values[i + NX * (j + NY * k)] != expected);
+        }
+      }
+    }
+    REQUIRE(nwrong == 0);
+  }
+
+  SECTION("5D loops visit every index exactly once") {
+    portableFor(
+        "5D host parallel", HostParallel(), 0, NB, 0, NA, 0, NZ, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int b, const int a, const int k, const int j, const int i) {
+          v[i + NX * (j + NY * (k + NZ * (a + NA * b)))] += 1;
+        });
+    int nwrong = 0;
+    for (int i = 0; i < N; ++i) {
+      nwrong += (values[i] != 1);
+    }
+    REQUIRE(nwrong == 0);
+  }
+
+  SECTION("Reductions agree with the serial host space") {
+    long serial = 0;
+    portableReduce(
+        "serial sum", PortsOfCall::Exec::Host(), 0, NZ, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int k, const int j, const int i, long &s) {
+          s += i + 2 * j + 3 * k;
+        },
+        serial);
+    long parallel = 0;
+    portableReduce(
+        "parallel sum", HostParallel(), 0, NZ, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int k, const int j, const int i, long &s) {
+          s += i + 2 * j + 3 * k;
+        },
+        parallel);
+    REQUIRE(parallel == serial);
+  }
+
+  SECTION("Empty ranges do nothing") {
+    int sum = 0;
+    portableReduce(
+        "empty sum", HostParallel(), 4, 4,
+        PORTABLE_LAMBDA(const int /*i*/, int &s) { s += 1; }, sum);
+    REQUIRE(sum == 0);
+  }
+}
+
+#ifdef PORTABILITY_STRATEGY_NONE
+TEST_CASE("ThreadPool supports nested loops and propagates exceptions", "[ThreadPool]") {
+  PortsOfCall::impl::ThreadPool pool(3);
+  REQUIRE(pool.NumThreads() == 3);
+
+  SECTION("Nested submissions complete") {
+    std::atomic<int> count{0};
+    pool.ForEachBlock(4, [&](std::int64_t) {
+      pool.ForEachBlock(5, [&](std::int64_t) { count++; });
+    });
+    REQUIRE(count == 20);
+  }
+
+  SECTION("Exceptions thrown by a block reach the caller") {
+    REQUIRE_THROWS(pool.ForEachBlock(8, [](std::int64_t b) {
+      if (b == 5) throw std::runtime_error("block failed");
+    }));
+  }
+
+  SECTION("A static split runs its first block on the calling thread") {
+    for (const auto bind : {PortsOfCall::impl::ThreadPool::ProcBind::Close,
+                            PortsOfCall::impl::ThreadPool::ProcBind::Spread,
+                            PortsOfCall::impl::ThreadPool::ProcBind::None}) {
+      pool.SetProcBind(bind);
+      REQUIRE(pool.GetProcBind() == bind);
+      std::vector<std::thread::id> ran_on(3);
+      std::atomic<int> count{0};
+      pool.ForEachBlock(3, [&](std::int64_t b) {
+        ran_on[b] = std::this_thread::get_id();
+        count++;
+      });
+      REQUIRE(count == 3);
+      REQUIRE(ran_on[0] == std::this_thread::get_id());
+    }
+  }
+
+#ifdef __linux__
+  SECTION("Binding pins the workers only") {
+    cpu_set_t before, after;
+    sched_getaffinity(0, sizeof(before), &before);
+    pool.SetProcBind(PortsOfCall::impl::ThreadPool::ProcBind::Close);
+    pool.ForEachBlock(3, [](std::int64_t) {});
+    sched_getaffinity(0, sizeof(after), &after);
+    REQUIRE(CPU_EQUAL(&before, &after));
+    pool.SetProcBind(PortsOfCall::impl::ThreadPool::ProcBind::None);
+  }
+#endif // __linux__
+}
+#endif // PORTABILITY_STRATEGY_NONE
+
+TEST_CASE("The memory pool caches freed blocks by size class", "[portableMalloc]") {
+  using PortsOfCall::Exec::Device;
+  auto &pool = PortsOfCall::MemoryPoolOf(Device());
+  REQUIRE(&pool == &PortsOfCall::MemoryPoolOf());
+  pool.Trim();
+  pool.ResetStats();
+
+  SECTION("Size classes round up by at most a quarter") {
+    REQUIRE(PortsOfCall::MemoryPool::ClassSize(1) == 256);
+    REQUIRE(PortsOfCall::MemoryPool::ClassSize(257) == 320);
+    REQUIRE(PortsOfCall::MemoryPool::ClassSize(1000) == 1024);
+    REQUIRE(PortsOfCall::MemoryPool::ClassSize(1025) == 1280);
+    for (std::size_t bytes = 300; bytes < (1 << 20); bytes = bytes * 3 / 2) {
+      const std::size_t size = PortsOfCall::MemoryPool::ClassSize(bytes);
+      REQUIRE(size >= bytes);
+      REQUIRE(size <= bytes + bytes / 4 + 1);
+    }
+  }
+
+  SECTION("Without a capacity nothing is cached") {
+    const std::size_t capacity = pool.Capacity();
+    pool.SetCapacity(0);
+    void *p = PORTABLE_MALLOC(1000);
+    PORTABLE_FREE(p);
+    REQUIRE(pool.Stats().hits == 0);
+    REQUIRE(pool.Stats().bytes_cached == 0);
+    pool.SetCapacity(capacity);
+  }
+
+  SECTION("Freed blocks are reused, up to the capacity") {
+    const std::size_t capacity = pool.Capacity();
+    pool.SetCapacity(1 << 20);
+    void *a = PORTABLE_MALLOC(1000);
+    REQUIRE(pool.Stats().misses == 1);
+    REQUIRE(pool.Stats().bytes_in_use == 1024);
+    PORTABLE_FREE(a);
+    REQUIRE(pool.Stats().bytes_cached == 1024);
+    // the same class, so the same block
+    void *b = PORTABLE_MALLOC(900);
+    REQUIRE(b == a);
+    REQUIRE(pool.Stats().hits == 1);
+    REQUIRE(pool.Stats().bytes_cached == 0);
+
+    // too large to ever be cached
+    void *big = PORTABLE_MALLOC(2 << 20);
+    REQUIRE(pool.Stats().misses == 1);
+    PORTABLE_FREE(big);
+    REQUIRE(pool.Stats().bytes_cached == 0);
+
+    // freed beyond the capacity, so released
+    std::vector<void *> blocks;
+    for (int i = 0; i < 5; ++i) {
+      blocks.push_back(PORTABLE_MALLOC(300 << 10));
+    }
+    for (void *p : blocks) {
+      PORTABLE_FREE(p);
+    }
+    REQUIRE(pool.Stats().bytes_cached ==
+            3 * PortsOfCall::MemoryPool::ClassSize(300 << 10));
+
+    pool.SetCapacity(512 << 10);
+    REQUIRE(pool.Stats().bytes_cached <= (512 << 10));
+    pool.Trim();
+    REQUIRE(pool.Stats().bytes_cached == 0);
+    PORTABLE_FREE(b);
+    pool.SetCapacity(capacity);
+    pool.Trim();
+  }
+
+  SECTION("Threads allocate and free concurrently") {
+    auto &host_pool = PortsOfCall::MemoryPoolOf(PortsOfCall::Exec::Host());
+    const std::size_t capacity = host_pool.Capacity();
+    host_pool.SetCapacity(8 << 20);
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int i = 0; i < 200; ++i) {
+          const std::size_t bytes = 256 + 64 * ((i * 7 + t) % 50);
+          auto *p = static_cast<unsigned char *>(
+              PortsOfCall::portableMalloc(PortsOfCall::Exec::Host(), bytes));
+          std::fill(p, p + bytes, static_cast<unsigned char>(t));
+          if (std::count(p, p + bytes, static_cast<unsigned char>(t)) !=
+              static_cast<std::ptrdiff_t>(bytes)) {
+            failures++;
+          }
+          PortsOfCall::portableFree(PortsOfCall::Exec::Host(), p);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    REQUIRE(failures == 0);
+    REQUIRE(host_pool.Stats().bytes_in_use == 0);
+    REQUIRE(host_pool.Stats().hits > 0);
+    host_pool.SetCapacity(capacity);
+    host_pool.Trim();
+  }
+
+  SECTION("A freed block is fenced before it is cached") {
+    static int fences = 0;
+    fences = 0;
+    PortsOfCall::MemoryPool fenced(&std::malloc, &std::free, []() { fences++; });
+    fenced.SetCapacity(1 << 20);
+    void *a = fenced.Allocate(1000);
+    REQUIRE(fences == 0);
+    fenced.Free(a);
+    REQUIRE(fences == 1);
+    REQUIRE(fenced.Allocate(1000) == a);
+    fenced.Free(a);
+    REQUIRE(fences == 2);
+  }
+}
+
+TEST_CASE("portableMalloc aligns memory and requests huge pages", "[portableMalloc]") {
+  using PortsOfCall::HugePages;
+  using PortsOfCall::MallocOptions;
+  using PortsOfCall::Exec::Host;
+  const auto aligned_to = [](const void *p, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+  };
+
+  SECTION("Alignment") {
+    for (const std::size_t alignment : {std::size_t(64), std::size_t(4096),
+                                        std::size_t(2) << 20}) {
+      void *p = PortsOfCall::portableMalloc(Host(), 1000, {.alignment = alignment});
+      REQUIRE(p != nullptr);
+      REQUIRE(aligned_to(p, alignment));
+      std::fill_n(static_cast<char *>(p), 1000, 1);
+      PortsOfCall::portableFree(Host(), p);
+    }
+    Real *const x = static_cast<Real *>(
+        PORTABLE_MALLOC(100 * sizeof(Real), MallocOptions{.alignment = 64}));
+    REQUIRE(x != nullptr);
+    PORTABLE_FREE(x);
+  }
+
+  SECTION("Huge pages, falling back when none are reserved") {
+    constexpr std::size_t bytes = std::size_t(5) << 20;
+    for (const auto pages : {HugePages::Transparent, HugePages::Explicit}) {
+      auto *p = static_cast<char *>(
+          PortsOfCall::portableMalloc(Host(), bytes, {.huge_pages = pages}));
+      REQUIRE(p != nullptr);
+      REQUIRE(aligned_to(p, std::size_t(2) << 20));
+      std::fill_n(p, bytes, 1);
+      REQUIRE(std::count(p, p + bytes, 1) == static_cast<std::ptrdiff_t>(bytes));
+      const auto got = PortsOfCall::impl::HostAllocator::PagesOf(p);
+      if (pages == HugePages::Transparent) REQUIRE(got != HugePages::Explicit);
+      PortsOfCall::portableFree(Host(), p);
+      REQUIRE(PortsOfCall::impl::HostAllocator::PagesOf(p) == HugePages::None);
+    }
+  }
+
+  SECTION("With first touch") {
+    const MallocOptions options{.first_touch = true, .alignment = 4096};
+    auto *p = static_cast<char *>(
+        PortsOfCall::portableMalloc(PortsOfCall::Exec::HostParallel(), 10000, options));
+    REQUIRE(aligned_to(p, 4096));
+    REQUIRE(std::count(p, p + 10000, 0) == 10000);
+    PortsOfCall::portableFree(PortsOfCall::Exec::HostParallel(), p);
+  }
+}
+
+TEST_CASE("First-touch allocation zeroes host memory", "[portableMalloc]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  using PortsOfCall::Exec::HostParallel;
+  constexpr int N = 100003;
+  const PortsOfCall::MallocOptions first_touch{.first_touch = true};
+  auto *const x = static_cast<char *>(
+      PortsOfCall::portableMalloc(HostParallel(), N, first_touch));
+  REQUIRE(std::count(x, x + N, 0) == N);
+  int sum = 0;
+  portableReduce(
+      "touched", HostParallel(), 0, N,
+      PORTABLE_LAMBDA(const int i, int &s) { s += x[i]; }, sum);
+  REQUIRE(sum == 0);
+  PortsOfCall::portableFree(HostParallel(), x);
+
+  // the default space, through the macro
+  Real *const y = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real), first_touch));
+  REQUIRE(y != nullptr);
+  PORTABLE_FREE(y);
+}
+
+TEST_CASE("Asynchronous copies hand out chunks as they arrive", "[portableCopy]") {
+  constexpr int N = 10007;
+  constexpr int chunk = 1000;
+  std::vector<int> host(N);
+  for (int i = 0; i < N; ++i) {
+    host[i] = i;
+  }
+  int *const device = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  const PortsOfCall::AsyncCopyOptions options{.chunk_bytes = chunk * sizeof(int),
+                                              .nthreads = 3};
+
+  auto upload = portableCopyToDeviceAsync(device, host.data(), N * sizeof(int), options);
+  REQUIRE(upload.Size() == N);
+  REQUIRE(upload.NumChunks() == (N + chunk - 1) / chunk);
+  REQUIRE(upload.ChunkEnd(upload.NumChunks() - 1) == N);
+  std::vector<int> visits(upload.NumChunks(), 0);
+  upload.ForEachChunk([&](const std::int64_t lo, const std::int64_t hi) {
+    REQUIRE(hi - lo <= chunk);
+    visits[lo / chunk]++;
+    portableFor(
+        "double", lo, hi, PORTABLE_LAMBDA(const std::int64_t i) { device[i] *= 2; });
+  });
+  REQUIRE(upload.Done());
+  REQUIRE(std::count(visits.begin(), visits.end(), 1) == std::ssize(visits));
+
+  SECTION("waiting for one chunk or for all") {
+    std::vector<int> back(N, -1);
+    auto download =
+        portableCopyToHostAsync(back.data(), device, N * sizeof(int), options);
+    download.Wait(3);
+    REQUIRE(download.Arrived(3));
+    for (std::int64_t i = download.ChunkBegin(3); i < download.ChunkEnd(3); ++i) {
+      REQUIRE(back[i] == 2 * i);
+    }
+    download.Wait();
+    REQUIRE(download.Done());
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(back[i] == 2 * i);
+    }
+  }
+
+  SECTION("an empty copy is done at once") {
+    auto empty = portableCopyToHostAsync(host.data(), device, 0, options);
+    REQUIRE(empty.NumChunks() == 0);
+    REQUIRE(empty.Done());
+    empty.Wait();
+  }
+  PORTABLE_FREE(device);
+}
+
+TEST_CASE("Memory tracking reports live bytes and the high-water mark",
+          "[portableMalloc]") {
+  using PortsOfCall::Exec::Host;
+  namespace Tracking = PortsOfCall::MemoryTracking;
+  const bool was_enabled = Tracking::Enabled();
+  Tracking::Enable();
+  Tracking::ResetStats();
+  const auto before = PortsOfCall::MemoryStatsOf(Host());
+
+  void *a = PortsOfCall::portableMalloc(Host(), 1000, {.label = "density table"});
+  void *b = PortsOfCall::portableMalloc(Host(), 3000, {.alignment = 64});
+  auto stats = PortsOfCall::MemoryStatsOf(Host());
+  REQUIRE(stats.live_bytes == before.live_bytes + 4000);
+  REQUIRE(stats.live_allocations == before.live_allocations + 2);
+  REQUIRE(stats.allocations == 2);
+
+  std::ostringstream report;
+  Tracking::Report(report);
+  REQUIRE(report.str().find("density table") != std::string::npos);
+
+  PortsOfCall::portableFree(Host(), b);
+  stats = PortsOfCall::MemoryStatsOf(Host());
+  REQUIRE(stats.live_bytes == before.live_bytes + 1000);
+  REQUIRE(stats.high_water_bytes >= before.live_bytes + 4000);
+  REQUIRE(stats.frees == 1);
+
+  SECTION("allocations made while tracking is off are not counted") {
+    Tracking::Enable(false);
+    void *c = PortsOfCall::portableMalloc(Host(), 500);
+    REQUIRE(PortsOfCall::MemoryStatsOf(Host()).allocations == 2);
+    PortsOfCall::portableFree(Host(), c);
+    REQUIRE(PortsOfCall::MemoryStatsOf(Host()).frees == 1);
+    // but freeing a tracked allocation still is
+    PortsOfCall::portableFree(Host(), a);
+    REQUIRE(PortsOfCall::MemoryStatsOf(Host()).live_bytes == before.live_bytes);
+    a = nullptr;
+  }
+  PortsOfCall::portableFree(Host(), a);
+  Tracking::Enable(was_enabled);
+}
+
+#ifdef PORTABILITY_STRATEGY_OPENMP
+namespace {
+struct Moments {
+  double m0 = 0;
+  double m1 = 0;
+  Moments &operator+=(const Moments &other) {
+    m0 += other.m0;
+    m1 += other.m1;
+    return *this;
+  }
+};
+} // namespace
+
+TEST_CASE("OpenMP strategy parallelizes device loops and reduces class types",
+          "[portableFor][portableReduce][OpenMP]") {
+  constexpr int NY = 40, NX = 50;
+  std::vector<int> thread_of(NY * NX, -1);
+  int *const t = thread_of.data();
+  portableFor(
+      "record thread", 0, NY, 0, NX,
+      PORTABLE_LAMBDA(const int j, const int i) {
+        t[i + NX * j] = omp_get_thread_num();
+      });
+  int nunset = 0;
+  for (const int tid : thread_of) {
+    nunset += (tid < 0);
+  }
+  REQUIRE(nunset == 0);
+
+  Moments moments;
+  portableReduce(
+      "moments", 0, NY, 0, NX,
+      PORTABLE_LAMBDA(const int j, const int i, Moments &m) {
+        m.m0 += 1.0;
+        m.m1 += i + NX * j;
+      },
+      moments);
+  REQUIRE(moments.m0 == NY * NX);
+  REQUIRE(moments.m1 == 0.5 * (NY * NX) * (NY * NX - 1));
+}
+#endif // PORTABILITY_STRATEGY_OPENMP
+
+TEST_CASE("Tiled portableFor visits every index exactly once",
+          "[portableFor][TileSizes]") {
+  using PortsOfCall::TileSizes;
+  constexpr int NA = 3, NZ = 9, NY = 13, NX = 70;
+  constexpr int N = NA * NZ * NY * NX;
+  std::vector<int> values(N, 0);
+  int *const v = values.data();
+  auto count_wrong = [&](const int expected) {
+    int nwrong = 0;
+    for (const int x : values) {
+      nwrong += (x != expected);
+    }
+    return nwrong;
+  };
+
+  SECTION("Explicit tiles that do not divide the extents") {
+    portableFor(
+        "tiled 3D", PortsOfCall::Exec::Host(), TileSizes{4, 5, 16}, 0, NA * NZ, 0, NY,
+        0, NX, PORTABLE_LAMBDA(const int k, const int j, const int i) {
+          v[i + NX * (j + NY * k)] += 1;
+        });
+    REQUIRE(count_wrong(1) == 0);
+  }
+
+  SECTION("Automatically sized tiles on the parallel host space") {
+    portableFor(
+        "auto tiled 4D", PortsOfCall::Exec::HostParallel(), TileSizes<4>{}, 0, NA, 0,
+        NZ, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int a, const int k, const int j, const int i) {
+          v[i + NX * (j + NY * (k + NZ * a))] += 1;
+        });
+    REQUIRE(count_wrong(1) == 0);
+  }
+
+  SECTION("Mixed explicit and automatic extents on a 2D range") {
+    portableFor(
+        "tiled 2D", PortsOfCall::Exec::HostParallel(), TileSizes{0, 32}, 0, NA * NZ * NY,
+        0, NX, PORTABLE_LAMBDA(const int j, const int i) { v[i + NX * j] += 2; });
+    REQUIRE(count_wrong(2) == 0);
+  }
+}
+
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+TEST_CASE("Automatic tile sizes respect the tile budget", "[TileSizes]") {
+  using namespace PortsOfCall::impl;
+  SECTION("Large 3D ranges get a long inner tile and square outer tiles") {
+    const auto tiled = MakeTiledRange({0, 0, 0}, {512, 512, 512}, {0, 0, 0});
+    REQUIRE(tiled.tile[2] == AUTO_TILE_INNER);
+    REQUIRE(tiled.tile[1] == tiled.tile[0]);
+    REQUIRE(std::int64_t(tiled.tile[0]) * tiled.tile[1] * tiled.tile[2] <=
+            AUTO_TILE_VOLUME);
+  }
+  SECTION("Requested extents are kept and clipped to the range") {
+    const auto tiled = MakeTiledRange({0, 0, 0}, {2, 100, 100}, {8, 0, 10});
+    REQUIRE(tiled.tile[0] == 2);
+    REQUIRE(tiled.tile[2] == 10);
+    REQUIRE(tiled.NumTiles() == tiled.ntiles[0] * tiled.ntiles[1] * 10);
+  }
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+TEST_CASE("portableReduce supports reducer objects on every strategy",
+          "[portableReduce][Reducers]") {
+  constexpr int N = 1000;
+  Real *const x = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  // a V shape with its minimum, -1, at i = 700 and maximum at i = 0
+  portableFor(
+      "fill", 0, N, PORTABLE_LAMBDA(const int i) {
+        x[i] = (i < 700) ? (700 - i) / 10.0 - 1.0 : (i - 700) / 100.0 - 1.0;
+      });
+  PORTABLE_FENCE("filled");
+
+  SECTION("Single reducers overwrite their result") {
+    Real minval = 12345, maxval = -12345, total = 12345;
+    portableReduce(
+        "min", 0, N,
+        PORTABLE_LAMBDA(const int i, Real &v) { v = (x[i] < v) ? x[i] : v; },
+        PortsOfCall::Min<Real>(minval));
+    portableReduce(
+        "max", 0, N,
+        PORTABLE_LAMBDA(const int i, Real &v) { v = (x[i] > v) ? x[i] : v; },
+        PortsOfCall::Max<Real>(maxval));
+    portableReduce(
+        "sum", 0, N, PORTABLE_LAMBDA(const int /*i*/, Real &v) { v += 1.0; },
+        PortsOfCall::Sum<Real>(total));
+    REQUIRE(minval == -1.0);
+    REQUIRE(maxval == 69.0);
+    REQUIRE(total == N);
+  }
+
+  SECTION("Product and logical reducers") {
+    Real prod = 0;
+    portableReduce(
+        "prod", 0, 10, PORTABLE_LAMBDA(const int /*i*/, Real &v) { v *= 2.0; },
+        PortsOfCall::Prod<Real>(prod));
+    REQUIRE(prod == 1024.0);
+    int all_finite = 0, any_negative = 0;
+    portableReduce(
+        "and/or", 0, N,
+        PORTABLE_LAMBDA(const int i, int &all, int &any) {
+          all = all && (x[i] < 1.0e10);
+          any = any || (x[i] < 0.0);
+        },
+        PortsOfCall::LAnd<int>(all_finite), PortsOfCall::LOr<int>(any_negative));
+    REQUIRE(all_finite == 1);
+    REQUIRE(any_negative == 1);
+  }
+
+  SECTION("Location reducers fused with a sum in one traversal") {
+    using ValLoc = PortsOfCall::ValLoc<Real, int>;
+    ValLoc minloc, maxloc;
+    int count = 0;
+    portableReduce(
+        "fused", PortsOfCall::Exec::Device(), 0, N / 10, 0, 10,
+        PORTABLE_LAMBDA(const int j, const int i, ValLoc &lo, ValLoc &hi, int &c) {
+          const int k = i + 10 * j;
+          if (x[k] < lo.val) {
+            lo.val = x[k];
+            lo.loc = k;
+          }
+          if (x[k] > hi.val) {
+            hi.val = x[k];
+            hi.loc = k;
+          }
+          c += 1;
+        },
+        PortsOfCall::MinLoc<Real, int>(minloc), PortsOfCall::MaxLoc<Real, int>(maxloc),
+        PortsOfCall::Sum<int>(count));
+    REQUIRE(minloc.val == -1.0);
+    REQUIRE(minloc.loc == 700);
+    REQUIRE(maxloc.val == 69.0);
+    REQUIRE(maxloc.loc == 0);
+    REQUIRE(count == N);
+  }
+
+  SECTION("Reducers work on the parallel host space") {
+    std::vector<Real> h(N);
+    portableCopyToHost(h.data(), x, N * sizeof(Real));
+    const Real *const hx = h.data();
+    Real minval = 0;
+    PortsOfCall::Min<Real> reducer(minval);
+    portableReduce(
+        "host min", PortsOfCall::Exec::HostParallel(), 0, N,
+        PORTABLE_LAMBDA(const int i, Real &v) { v = (hx[i] < v) ? hx[i] : v; }, reducer);
+    REQUIRE(minval == -1.0);
+  }
+
+  PORTABLE_FREE(x);
+}
+
+namespace {
+// Zone diagnostics gathered in one pass, finished by final
+struct Diagnostics {
+  Real mass;
+  Real energy;
+  Real momentum;
+  Real dtmin;
+  int zones;
+};
+struct DiagnosticsReducer : PortsOfCall::Reducer<DiagnosticsReducer, Diagnostics> {
+  using Reducer::Reducer;
+  PORTABLE_INLINE_FUNCTION void init(Diagnostics &d) const {
+    d = {0, 0, 0, 1e30, 0};
+  }
+  PORTABLE_INLINE_FUNCTION void join(Diagnostics &dest, const Diagnostics &src) const {
+    dest.mass += src.mass;
+    dest.energy += src.energy;
+    dest.momentum += src.momentum;
+    dest.dtmin = (src.dtmin < dest.dtmin) ? src.dtmin : dest.dtmin;
+    dest.zones += src.zones;
+  }
+  // specific energy from the totals
+  void final(Diagnostics &d) const { d.energy /= d.mass; }
+};
+} // namespace
+
+TEST_CASE("Custom reducers join partial structs and apply final",
+          "[portableReduce][Reducers]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  STATIC_REQUIRE(PortsOfCall::is_reducer_v<DiagnosticsReducer>);
+  STATIC_REQUIRE(PortsOfCall::has_final_v<DiagnosticsReducer>);
+  STATIC_REQUIRE(!PortsOfCall::has_final_v<PortsOfCall::Sum<Real>>);
+  constexpr int NY = 20, NX = 50;
+  constexpr int N = NY * NX;
+  // zone (j, i) has mass 2, energy 6, momentum i - j and dt 1 + (i + j) % 17
+  const auto zone = PORTABLE_LAMBDA(const int j, const int i, Diagnostics &d) {
+    d.mass += 2;
+    d.energy += 6;
+    d.momentum += i - j;
+    const Real dt = 1 + (i + j) % 17 + 0.5 * (i == 30 && j == 7);
+    d.dtmin = (dt < d.dtmin) ? dt : d.dtmin;
+    d.zones += 1;
+  };
+  const auto check = [&](const Diagnostics &d) {
+    REQUIRE(d.mass == 2 * N);
+    REQUIRE(d.energy == 3);
+    REQUIRE(d.momentum == NY * NX * (NX - 1) / 2 - NX * NY * (NY - 1) / 2);
+    REQUIRE(d.dtmin == 1);
+    REQUIRE(d.zones == N);
+  };
+
+  SECTION("On the default space") {
+    Diagnostics d{};
+    portableReduce("diagnostics", 0, NY, 0, NX, zone, DiagnosticsReducer(d));
+    check(d);
+  }
+
+  SECTION("Alongside a built-in reducer") {
+    Diagnostics d{};
+    int count = 0;
+    portableReduce(
+        "diagnostics and count", 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int j, const int i, Diagnostics &dd, int &c) {
+          zone(j, i, dd);
+          c += 1;
+        },
+        DiagnosticsReducer(d), PortsOfCall::Sum<int>(count));
+    check(d);
+    REQUIRE(count == N);
+  }
+
+  SECTION("On the parallel host space, with every schedule and deterministically") {
+    using PortsOfCall::Exec::HostParallel;
+    Diagnostics d{};
+    portableReduce("host", HostParallel(), 0, NY, 0, NX, zone, DiagnosticsReducer(d));
+    check(d);
+    for (const auto schedule :
+         {PortsOfCall::Schedule::Dynamic(7), PortsOfCall::Schedule::Guided()}) {
+      Diagnostics ds{};
+      portableReduce("scheduled", HostParallel(), schedule, 0, NY, 0, NX, zone,
+                     DiagnosticsReducer(ds));
+      check(ds);
+    }
+    Diagnostics dd{};
+    portableReduce("deterministic", HostParallel(), PortsOfCall::Deterministic{64}, 0, NY,
+                   0, NX, zone, DiagnosticsReducer(dd));
+    check(dd);
+  }
+}
+
+TEST_CASE("Scheduled loops and reductions cover the index space once",
+          "[portableFor][portableReduce][Schedule]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  using PortsOfCall::Schedule;
+  using PortsOfCall::Exec::HostParallel;
+  constexpr int NY = 37, NX = 29;
+  constexpr int N = NY * NX;
+  std::vector<int> values(N);
+  int *const v = values.data();
+  int *const d = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  std::vector<int> h(N);
+  for (const Schedule schedule : {Schedule::Static(), Schedule::Dynamic(),
+                                  Schedule::Dynamic(64), Schedule::Guided(4)}) {
+    std::fill(values.begin(), values.end(), 0);
+    // the cost of an iteration grows with its index, as in a particle bin
+    portableFor(
+        "imbalanced", HostParallel(), schedule, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int j, const int i) {
+          int work = 0;
+          for (int k = 0; k < j * i; ++k) {
+            work += k % 3;
+          }
+          v[i + NX * j] += 1 + (work < 0);
+        });
+    for (int n = 0; n < N; ++n) {
+      REQUIRE(values[n] == 1);
+    }
+
+    int sum = 0;
+    portableReduce(
+        "sum", HostParallel(), schedule, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int j, const int i, int &s) { s += v[i + NX * j] + i; },
+        sum);
+    REQUIRE(sum == N + NY * NX * (NX - 1) / 2);
+
+    // int bounds give int indices even when reducing into a double
+    double wide = 0;
+    portableReduce(
+        "int indices", HostParallel(), schedule, 0, N,
+        PORTABLE_LAMBDA(const auto n, double &s) {
+          s += std::is_same_v<std::decay_t<decltype(n)>, int>;
+        },
+        wide);
+    REQUIRE(wide == N);
+
+    int maxval = 0, count = 0;
+    portableReduce(
+        "max and count", HostParallel(), schedule, std::int64_t(0), std::int64_t(N),
+        PORTABLE_LAMBDA(const std::int64_t n, int &m, int &c) {
+          m = std::max(m, static_cast<int>(n));
+          c += v[n];
+        },
+        PortsOfCall::Max<int>(maxval), PortsOfCall::Sum<int>(count));
+    REQUIRE(maxval == N - 1);
+    REQUIRE(count == N);
+
+    portableFor(
+        "default space", schedule, 0, N, PORTABLE_LAMBDA(const int n) { d[n] = 2 * n; });
+    PORTABLE_FENCE();
+    portableCopyToHost(h.data(), d, N * sizeof(int));
+    for (int n = 0; n < N; ++n) {
+      REQUIRE(h[n] == 2 * n);
+    }
+  }
+
+  PORTABLE_FREE(d);
+}
+
+TEST_CASE("Deterministic reductions do not depend on the thread count",
+          "[portableReduce][Deterministic]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  using PortsOfCall::Deterministic;
+  using PortsOfCall::Exec::HostParallel;
+  constexpr int NY = 61, NX = 83;
+  constexpr int N = NY * NX;
+  // terms of wildly different magnitude, so the order of additions shows
+  std::vector<double> values(N);
+  for (int n = 0; n < N; ++n) {
+    values[n] = (n % 7 == 0 ? 1e12 : 1e-3) * (n % 2 ? -1.0 : 1.0) + 0.1 * n;
+  }
+  const double *const v = values.data();
+  const Deterministic mode{64};
+
+  // the same chunks and tree, serially
+  const int nchunks = (N + mode.chunk - 1) / mode.chunk;
+  std::vector<double> partials(nchunks, 0.0);
+  for (int n = 0; n < N; ++n) {
+    partials[n / mode.chunk] += values[n];
+  }
+  for (int stride = 1; stride < nchunks; stride *= 2) {
+    for (int c = 0; c + stride < nchunks; c += 2 * stride) {
+      partials[c] += partials[c + stride];
+    }
+  }
+  const double expected = partials[0];
+
+  const auto sums = [&]() {
+    double flat = 0, nested = 0, largest = 0;
+    portableReduce(
+        "flat", HostParallel(), mode, 0, N,
+        PORTABLE_LAMBDA(const int n, double &s) { s += v[n]; }, flat);
+    portableReduce(
+        "nested", HostParallel(), mode, 0, NY, 0, NX,
+        PORTABLE_LAMBDA(const int j, const int i, double &s) { s += v[i + NX * j]; },
+        nested);
+    portableReduce(
+        "largest", HostParallel(), mode, 0, N,
+        PORTABLE_LAMBDA(const int n, double &m) { m = std::max(m, v[n]); },
+        PortsOfCall::Max<double>(largest));
+    return std::vector<double>{flat, nested, largest};
+  };
+  const double largest = *std::max_element(values.begin(), values.end());
+  for (const int nthreads : {1, 2, 3, 4}) {
+#ifdef PORTABILITY_STRATEGY_KOKKOS
+    const auto results = sums();
+#else
+    const PortsOfCall::impl::ScopedConcurrency concurrency(nthreads);
+    const auto results = sums();
+#endif
+    INFO("threads: " << nthreads);
+    REQUIRE(results[0] == expected);
+    REQUIRE(results[1] == expected);
+    REQUIRE(results[2] == largest);
+  }
+
+  int count = 0;
+  portableReduce(
+      "empty", HostParallel(), mode, 5, 5, PORTABLE_LAMBDA(const int, int &c) { c++; },
+      count);
+  REQUIRE(count == 0);
+
+  // int bounds give int indices even when reducing into a double
+  double wide = 0;
+  portableReduce(
+      "int indices", HostParallel(), mode, 0, N,
+      PORTABLE_LAMBDA(const auto n, double &s) {
+        s += std::is_same_v<std::decay_t<decltype(n)>, int>;
+      },
+      wide);
+  REQUIRE(wide == N);
+}
+
+TEST_CASE("portableForTuned picks and caches a configuration",
+          "[portableFor][Autotune]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  namespace Autotune = PortsOfCall::Autotune;
+  constexpr int NY = 24, NX = 40;
+  constexpr int N = NY * NX;
+  int *const d = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  std::vector<int> h(N);
+  const auto check = [&](int launch) {
+    PORTABLE_FENCE();
+    portableCopyToHost(h.data(), d, N * sizeof(int));
+    for (int n = 0; n < N; ++n) {
+      REQUIRE(h[n] == n + launch);
+    }
+  };
+
+  SECTION("Disabled, it is portableFor") {
+    REQUIRE(!Autotune::Enabled());
+    portableForTuned(
+        "untuned", 0, NY, 0, NX, PORTABLE_LAMBDA(const int j, const int i) {
+          d[i + NX * j] = i + NX * j;
+        });
+    check(0);
+    REQUIRE(!Autotune::Chosen("untuned", N));
+  }
+
+  SECTION("Enabled, it tunes once and remembers") {
+    const std::string cache = "ports-of-call-autotune-test.txt";
+    std::remove(cache.c_str());
+    Autotune::SetCacheFile(cache);
+    Autotune::Enable();
+    int launch = 0;
+    for (; launch < 100 && !Autotune::Chosen("tuned", N); ++launch) {
+      portableForTuned(
+          "tuned", 0, NY, 0, NX, PORTABLE_LAMBDA(const int j, const int i) {
+            d[i + NX * j] = i + NX * j + launch;
+          });
+      // every candidate must compute the same thing
+      check(launch);
+    }
+    const auto chosen = Autotune::Chosen("tuned", N);
+    REQUIRE(chosen);
+    REQUIRE(launch > 1);
+    // a different size class is tuned separately
+    REQUIRE(!Autotune::Chosen("tuned", 4 * N));
+
+    Autotune::Reset();
+    const auto loaded = Autotune::Chosen("tuned", N);
+    REQUIRE(loaded);
+    REQUIRE(loaded->ToString() == chosen->ToString());
+    portableForTuned(
+        "tuned", 0, NY, 0, NX, PORTABLE_LAMBDA(const int j, const int i) {
+          d[i + NX * j] = i + NX * j + launch;
+        });
+    check(launch);
+
+    Autotune::Enable(false);
+    Autotune::Reset();
+    std::remove(cache.c_str());
+  }
+
+  SECTION("Overlapping trials are recorded against their own candidate") {
+    const std::string cache = "ports-of-call-autotune-overlap.txt";
+    std::remove(cache.c_str());
+    Autotune::SetCacheFile(cache);
+    auto &registry = PortsOfCall::impl::AutotuneRegistry::Get();
+    const auto candidates = []() {
+      return std::vector<Autotune::Config>{{PortsOfCall::Schedule::Static(), {}, 0},
+                                           {PortsOfCall::Schedule::Dynamic(8), {}, 0}};
+    };
+    // every trial starts before any is recorded, as from several streams
+    std::vector<int> started;
+    for (int t = 0; t < 2 * registry.samples; ++t) {
+      started.push_back(registry.Next("overlap", N, candidates).second);
+    }
+    REQUIRE(started == std::vector<int>{0, 0, 1, 1});
+    // the second candidate, finishing first, is the faster
+    for (auto t = started.rbegin(); t != started.rend(); ++t) {
+      registry.Record("overlap", N, *t, *t == 1 ? 1.0 : 2.0);
+    }
+    const auto chosen = Autotune::Chosen("overlap", N);
+    REQUIRE(chosen);
+    REQUIRE(chosen->schedule.kind == PortsOfCall::Schedule::Kind::Dynamic);
+    Autotune::Reset();
+    std::remove(cache.c_str());
+  }
+
+  PORTABLE_FREE(d);
+}
+
+TEST_CASE("portableScan computes inclusive and exclusive prefix sums", "[portableScan]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  constexpr int N = 1001;
+  int *const counts = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  int *const scanned = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  portableFor(
+      "counts", 0, N, PORTABLE_LAMBDA(const int i) { counts[i] = i % 7; });
+  PORTABLE_FENCE("counts set");
+
+  std::vector<int> expected_excl(N), expected_incl(N);
+  int running = 0;
+  for (int i = 0; i < N; ++i) {
+    expected_excl[i] = running;
+    running += i % 7;
+    expected_incl[i] = running;
+  }
+  std::vector<int> h(N);
+
+  SECTION("Kokkos-style functor scan, exclusive, with total") {
+    int total = -1;
+    portableScan(
+        "exclusive", 0, N,
+        PORTABLE_LAMBDA(const int i, int &partial, const bool final) {
+          if (final) scanned[i] = partial;
+          partial += counts[i];
+        },
+        total);
+    portableCopyToHost(h.data(), scanned, N * sizeof(int));
+    REQUIRE(total == running);
+    REQUIRE(h == expected_excl);
+  }
+
+  SECTION("Inclusive convenience scan") {
+    int total = -1;
+    portableInclusiveScan(
+        "inclusive", 0, N, PORTABLE_LAMBDA(const int i) { return counts[i]; }, scanned,
+        total);
+    portableCopyToHost(h.data(), scanned, N * sizeof(int));
+    REQUIRE(total == running);
+    REQUIRE(h == expected_incl);
+  }
+
+  SECTION("Exclusive convenience scan in place on the parallel host space") {
+    std::vector<int> offsets(N);
+    for (int i = 0; i < N; ++i) {
+      offsets[i] = i % 7;
+    }
+    int *const o = offsets.data();
+    int total = -1;
+    portableExclusiveScan(
+        "in place", PortsOfCall::Exec::HostParallel(), 0, N,
+        PORTABLE_LAMBDA(const int i) { return o[i]; }, o, total);
+    REQUIRE(total == running);
+    REQUIRE(offsets == expected_excl);
+  }
+
+  SECTION("Empty scans produce a zero total") {
+    int total = -1;
+    portableScan(
+        "empty", 5, 5,
+        PORTABLE_LAMBDA(const int /*i*/, int &partial, const bool /*final*/) {
+          partial += 1;
+        },
+        total);
+    REQUIRE(total == 0);
+  }
+
+  PORTABLE_FREE(counts);
+  PORTABLE_FREE(scanned);
+}
+
+TEST_CASE("Index lists select, sort and gather active zones", "[portableForIndices]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  constexpr int N = 1000;
+  // zones divisible by 3 or 7 are active
+  const auto active = PORTABLE_LAMBDA(const int i) { return i % 3 == 0 || i % 7 == 0; };
+  std::vector<int> expected;
+  for (int i = 0; i < N; ++i) {
+    if (active(i)) expected.push_back(i);
+  }
+  const int nactive = static_cast<int>(expected.size());
+  int *const indices = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  Real *const x = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  std::vector<int> hindices(N);
+  std::vector<Real> hx(N);
+  portableFor(
+      "zero", 0, N, PORTABLE_LAMBDA(const int i) { x[i] = 0; });
+
+  SECTION("Selecting from a predicate gives the active zones in order") {
+    const int n = portableSelectIndices("select", 0, N, active, indices);
+    REQUIRE(n == nactive);
+    portableCopyToHost(hindices.data(), indices, n * sizeof(int));
+    for (int k = 0; k < n; ++k) {
+      REQUIRE(hindices[k] == expected[k]);
+    }
+
+    SECTION("A gathered loop touches only the listed zones") {
+      portableForIndices(
+          "gather", indices, n, PORTABLE_LAMBDA(const int i) { x[i] += i; });
+      portableForIndices(
+          "gather with prefetch", PortsOfCall::Exec::Device(), indices, n,
+          PORTABLE_LAMBDA(const int i) { x[i] += 1; },
+          PORTABLE_LAMBDA(const int i) { PortsOfCall::Prefetch(&x[i]); }, 4);
+      PORTABLE_FENCE();
+      portableCopyToHost(hx.data(), x, N * sizeof(Real));
+      for (int i = 0; i < N; ++i) {
+        REQUIRE(hx[i] == (active(i) ? i + 1 : 0));
+      }
+    }
+  }
+
+  SECTION("Sorting restores the order of a shuffled list") {
+    std::vector<int> shuffled(expected.rbegin(), expected.rend());
+    std::swap(shuffled[1], shuffled[nactive / 2]);
+    portableCopyToDevice(indices, shuffled.data(), nactive * sizeof(int));
+    portableSortIndices(indices, nactive);
+    PORTABLE_FENCE();
+    portableCopyToHost(hindices.data(), indices, nactive * sizeof(int));
+    for (int k = 0; k < nactive; ++k) {
+      REQUIRE(hindices[k] == expected[k]);
+    }
+  }
+
+  PORTABLE_FREE(indices);
+  PORTABLE_FREE(x);
+}
+
+TEST_CASE("portableTeamFor runs nested team, thread and vector ranges",
+          "[portableTeamFor]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  constexpr int NZONES = 37;
+  constexpr int NMAT = 5;
+  constexpr int NCOMP = 9;
+  Real *const out = static_cast<Real *>(PORTABLE_MALLOC(NZONES * sizeof(Real)));
+  int *const ranks = static_cast<int *>(PORTABLE_MALLOC(NZONES * sizeof(int)));
+
+  auto check = [&]() {
+    std::vector<Real> h(NZONES);
+    std::vector<int> r(NZONES);
+    portableCopyToHost(h.data(), out, NZONES * sizeof(Real));
+    portableCopyToHost(r.data(), ranks, NZONES * sizeof(int));
+    for (int z = 0; z < NZONES; ++z) {
+      Real expected = 0;
+      for (int m = 0; m < NMAT; ++m) {
+        for (int c = 0; c < NCOMP; ++c) {
+          expected += z + m * c;
+        }
+      }
+      REQUIRE(h[z] == expected);
+      REQUIRE(r[z] == NZONES);
+    }
+  };
+  auto kernel = PORTABLE_LAMBDA(const PortsOfCall::TeamMember<> &member) {
+    const int z = member.league_rank();
+    Real *const frac = PortsOfCall::TeamScratch<Real>(member, NMAT);
+    PortsOfCall::TeamThreadFor(member, 0, NMAT, [&](const int m) {
+      Real sum = 0;
+      for (int c = 0; c < NCOMP; ++c) {
+        sum += z + m * c;
+      }
+      frac[m] = sum;
+    });
+    member.team_barrier();
+    if (member.team_rank() == 0) {
+      Real total = 0;
+      for (int m = 0; m < NMAT; ++m) {
+        total += frac[m];
+      }
+      out[z] = total;
+      ranks[z] = member.league_size();
+    }
+  };
+
+  SECTION("Default execution space") {
+    portableTeamFor("teams", NZONES, NMAT * sizeof(Real), kernel);
+    PORTABLE_FENCE("teams");
+    check();
+  }
+  SECTION("Vector lanes write disjoint scratch entries") {
+    portableTeamFor(
+        "vector", NZONES, NMAT * NCOMP * sizeof(Real),
+        PORTABLE_LAMBDA(const PortsOfCall::TeamMember<> &member) {
+          const int z = member.league_rank();
+          Real *const terms = PortsOfCall::TeamScratch<Real>(member, NMAT * NCOMP);
+          PortsOfCall::TeamThreadFor(member, 0, NMAT, [&](const int m) {
+            PortsOfCall::ThreadVectorFor(member, 0, NCOMP, [&](const int c) {
+              terms[m * NCOMP + c] = z + m * c;
+            });
+          });
+          member.team_barrier();
+          if (member.team_rank() == 0) {
+            Real total = 0;
+            for (int k = 0; k < NMAT * NCOMP; ++k) {
+              total += terms[k];
+            }
+            out[z] = total;
+            ranks[z] = member.league_size();
+          }
+        });
+    PORTABLE_FENCE("vector");
+    check();
+  }
+
+  PORTABLE_FREE(out);
+  PORTABLE_FREE(ranks);
+}
+
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+TEST_CASE("Host team scratch is per team and bounded", "[portableTeamFor]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  constexpr int NTEAMS = 16;
+  std::vector<int> ok(NTEAMS, 0);
+  int *const o = ok.data();
+  portableTeamFor(
+      "scratch", PortsOfCall::Exec::HostParallel(), NTEAMS, 4 * sizeof(double),
+      [=](const PortsOfCall::TeamMember<PortsOfCall::Exec::HostParallel> &member) {
+        char *const c = PortsOfCall::TeamScratch<char>(member, 1);
+        double *const d = PortsOfCall::TeamScratch<double>(member, 3);
+        double *const none = PortsOfCall::TeamScratch<double>(member, 1);
+        const bool aligned = reinterpret_cast<std::uintptr_t>(d) % alignof(double) == 0;
+        o[member.league_rank()] = c != nullptr && d != nullptr && none == nullptr &&
+                                  aligned && member.team_size() == 1;
+      });
+  REQUIRE(std::count(ok.begin(), ok.end(), 1) == NTEAMS);
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+TEST_CASE("Execution space instances order work and fence individually",
+          "[portableFor][PORTABLE_FENCE][instances]") {
+#ifdef PORTABILITY_STRATEGY_NONE
+  PortsOfCall::impl::ThreadPool::Global().Resize(4);
+#endif
+  using PortsOfCall::Exec::Device;
+  constexpr int N = 4096;
+  auto instances = PortsOfCall::MakeInstances(Device(), 2);
+  REQUIRE(instances.size() == 2);
+  const Device &a = instances[0];
+  const Device &b = instances[1];
+  int *const x = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  int *const y = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  std::vector<int> hx(N, 3), hy(N);
+
+  SECTION("Launches on one instance run in order") {
+    portableCopyToDevice(a, x, hx.data(), N * sizeof(int));
+    portableFor(
+        "double", a, 0, N, PORTABLE_LAMBDA(const int i) { x[i] *= 2; });
+    portableFor(
+        "increment", a, 0, N, PORTABLE_LAMBDA(const int i) { x[i] += i; });
+    int sum = 0;
+    portableReduce(
+        "sum", a, 0, N, PORTABLE_LAMBDA(const int i, int &s) { s += x[i]; }, sum);
+    REQUIRE(sum == 6 * N + N * (N - 1) / 2);
+    portableCopyToHost(a, hy.data(), x, N * sizeof(int));
+    PORTABLE_FENCE(a, "copy back");
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(hy[i] == 6 + i);
+    }
+  }
+
+  SECTION("Events order work across instances") {
+    portableFor(
+        "slow producer", a, 0, 1, PORTABLE_LAMBDA(const int /*i*/) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        });
+    portableFor(
+        "producer", a, 0, N, PORTABLE_LAMBDA(const int i) { x[i] = i; });
+    PortsOfCall::Event<Device> produced;
+    produced.Record(a);
+    PortsOfCall::portableWaitEvent(b, produced);
+    portableFor(
+        "consumer", b, 0, N, PORTABLE_LAMBDA(const int i) { y[i] = x[i] + 1; });
+    PORTABLE_FENCE(b);
+    produced.Wait();
+    portableCopyToHost(hy.data(), y, N * sizeof(int));
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(hy[i] == i + 1);
+    }
+  }
+
+  PORTABLE_FENCE();
+  PORTABLE_FREE(x);
+  PORTABLE_FREE(y);
+}
+
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+TEST_CASE("Host stream instances overlap and report errors at fences", "[instances]") {
+  using PortsOfCall::Exec::Host;
+  auto instances = PortsOfCall::MakeInstances(Host(), 2);
+  std::atomic<bool> released{false};
+  std::atomic<bool> saw_release{false};
+  std::atomic<bool> *const r = &released;
+  std::atomic<bool> *const s = &saw_release;
+
+  SECTION("A kernel on one instance can wait for a kernel on another") {
+    // If the instances were serialized, the first loop would time out
+    portableFor("waiter", instances[0], 0, 1, [=](const int /*i*/) {
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (!r->load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+      s->store(r->load());
+    });
+    portableFor("releaser", instances[1], 0, 1, [=](const int /*i*/) { r->store(true); });
+    PORTABLE_FENCE("both");
+    REQUIRE(saw_release.load());
+  }
+
+  SECTION("Work on an instance may drop its last copy") {
+    auto last = PortsOfCall::MakeInstances(Host(), 1)[0];
+    std::atomic<bool> drained{false};
+    std::atomic<bool> *const d = &drained;
+    portableFor("holds the last copy", last, 0, 1, [=](const int /*i*/) {
+      while (!r->load()) {
+        std::this_thread::yield();
+      }
+      (void)last;
+    });
+    portableFor("queued behind it", last, 0, 1, [=](const int /*i*/) { d->store(true); });
+    last = Host();
+    released = true;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!drained.load() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    REQUIRE(drained.load());
+  }
+
+#ifdef PORTABILITY_STRATEGY_NONE
+  // OpenMP loop bodies may not throw
+  SECTION("Exceptions surface at the next fence of their instance") {
+    portableFor("throws", instances[0], 0, 1,
+                [](const int /*i*/) { throw std::runtime_error("boom"); });
+    REQUIRE_THROWS_AS(PORTABLE_FENCE(instances[0]), std::runtime_error);
+    REQUIRE_NOTHROW(PORTABLE_FENCE(instances[0]));
+  }
+#endif // PORTABILITY_STRATEGY_NONE
+}
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+TEST_CASE("Graphs replay a recorded sequence of launches", "[Graph][instances]") {
+  using PortsOfCall::Exec::Device;
+  constexpr int N = 1000;
+  Real *const x = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  Real *const y = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  Real *const sum = static_cast<Real *>(PORTABLE_MALLOC(sizeof(Real)));
+  std::vector<Real> hx(N), hy(N);
+  Real hsum = 0;
+
+  const auto record = [&](PortsOfCall::Graph<Device> &graph) {
+    graph.AddCopyToDevice(x, hx.data(), N * sizeof(Real));
+    const auto scaled = graph.AddFor(
+        "scale", 0, N, PORTABLE_LAMBDA(const int i) { x[i] = 2 * x[i]; });
+    // both depend on scale, not on each other
+    const auto shifted = graph.AddFor(
+        "shift", {scaled}, 0, N, PORTABLE_LAMBDA(const int i) { y[i] = x[i] + 1; });
+    const auto summed = graph.AddReduce(
+        "sum", {scaled}, 0, N, PORTABLE_LAMBDA(const int i, Real &s) { s += x[i]; }, sum);
+    graph.AddCopyToHost({shifted}, hy.data(), y, N * sizeof(Real));
+    graph.AddCopyToHost({summed}, &hsum, sum, sizeof(Real));
+    REQUIRE(graph.Size() == 6);
+  };
+  const auto replay = [&](PortsOfCall::Graph<Device> &graph) {
+    for (int cycle = 0; cycle < 3; ++cycle) {
+      for (int i = 0; i < N; ++i) {
+        hx[i] = i + cycle;
+      }
+      graph.Submit();
+      graph.Fence();
+      REQUIRE(hsum == 2 * (N * (N - 1) / 2 + N * cycle));
+      for (int i = 0; i < N; ++i) {
+        REQUIRE(hy[i] == 2 * (i + cycle) + 1);
+      }
+    }
+  };
+
+  SECTION("On the default instance") {
+    PortsOfCall::Graph<Device> graph;
+    record(graph);
+    replay(graph);
+  }
+
+  SECTION("On an instance with its own queue") {
+    PortsOfCall::Graph<Device> graph(PortsOfCall::MakeInstances(Device(), 1)[0]);
+    record(graph);
+    graph.Instantiate();
+    replay(graph);
+  }
+
+  PORTABLE_FREE(x);
+  PORTABLE_FREE(y);
+  PORTABLE_FREE(sum);
+}
+
+TEST_CASE("Kernel timing records calls and iterations by name", "[Timing]") {
+  namespace Timing = PortsOfCall::Timing;
+  const bool was_enabled = Timing::Enabled();
+  Timing::Reset();
+  constexpr int N = 64;
+  int *const a = static_cast<int *>(PORTABLE_MALLOC(N * N * sizeof(int)));
+
+  SECTION("Nothing is recorded while disabled") {
+    Timing::Enable(false);
+    portableFor(
+        "timing: untimed", 0, N, PORTABLE_LAMBDA(const int i) { a[i] = i; });
+    REQUIRE(Timing::Snapshot().empty());
+  }
+
+  SECTION("Enabled timing aggregates per kernel name") {
+    Timing::Enable();
+    for (int rep = 0; rep < 3; ++rep) {
+      portableFor(
+          "timing: fill", 0, N, 0, N,
+          PORTABLE_LAMBDA(const int j, const int i) { a[i + N * j] = i + j; });
+    }
+    int sum = 0;
+    portableReduce(
+        "timing: \"sum\"", 0, N * N,
+        PORTABLE_LAMBDA(const int i, int &s) { s += a[i]; }, sum);
+    PORTABLE_FENCE();
+    const auto stats = Timing::Snapshot();
+    REQUIRE(stats.size() == 2);
+    for (const auto &s : stats) {
+      REQUIRE(s.min_seconds <= s.max_seconds);
+      REQUIRE(s.total_seconds >= s.max_seconds);
+      if (s.name == "timing: fill") {
+        REQUIRE(s.calls == 3);
+        REQUIRE(s.iterations == 3 * N * N);
+      } else {
+        REQUIRE(s.name == "timing: \"sum\"");
+        REQUIRE(s.calls == 1);
+        REQUIRE(s.iterations == N * N);
+      }
+    }
+    std::ostringstream json;
+    Timing::Report(json, Timing::Format::Json);
+    REQUIRE(json.str().find("\"name\": \"timing: \\\"sum\\\"\"") != std::string::npos);
+    std::ostringstream table;
+    Timing::Report(table);
+    REQUIRE(table.str().find("timing: fill") != std::string::npos);
+  }
+
+  SECTION("Launches on an instance are timed once, where they run") {
+    Timing::Enable();
+    auto instances = PortsOfCall::MakeInstances(PortsOfCall::Exec::Device(), 1);
+    portableFor(
+        "timing: async", instances[0], 0, N, PORTABLE_LAMBDA(const int i) { a[i] = i; });
+    PORTABLE_FENCE(instances[0]);
+    const auto stats = Timing::Snapshot();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].name == "timing: async");
+    REQUIRE(stats[0].calls == 1);
+  }
+
+  Timing::Enable(was_enabled);
+  Timing::Reset();
+  PORTABLE_FREE(a);
+}
+
+TEST_CASE("One-dimensional loops accept 64-bit bounds", "[portableFor][portableReduce]") {
+  constexpr int N = 100;
+  constexpr std::int64_t base = std::int64_t(1) << 31;
+  int *const a = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  int *const b = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+
+  SECTION("Bounds past 2^31 use a 64-bit index") {
+    portableFor(
+        "int64 fill", base, base + N,
+        PORTABLE_LAMBDA(const std::int64_t i) { a[i - base] = static_cast<int>(i % 7); });
+    std::int64_t sum = 0;
+    portableReduce(
+        "int64 sum", base, base + N,
+        PORTABLE_LAMBDA(const std::int64_t i, std::int64_t &s) { s += i - base; }, sum);
+    REQUIRE(sum == std::int64_t(N) * (N - 1) / 2);
+    std::int64_t last = 0;
+    portableReduce(
+        "int64 max", PortsOfCall::Exec::Host(), base, base + N,
+        PORTABLE_LAMBDA(const std::int64_t i, std::int64_t &m) { m = std::max(m, i); },
+        PortsOfCall::Max<std::int64_t>(last));
+    REQUIRE(last == base + N - 1);
+    std::int64_t parallel_sum = 0;
+    portableReduce(
+        "int64 parallel sum", PortsOfCall::Exec::HostParallel(), base, base + N,
+        PORTABLE_LAMBDA(const std::int64_t i, std::int64_t &s) { s += i - base; },
+        parallel_sum);
+    REQUIRE(parallel_sum == sum);
+    int total = 0;
+    portableScan(
+        "int64 scan", PortsOfCall::Exec::Device(), base, base + N,
+        PORTABLE_LAMBDA(const std::int64_t i, int &partial, const bool final) {
+          if (final) b[i - base] = partial;
+          partial += a[i - base];
+        },
+        total);
+    PORTABLE_FENCE();
+    std::vector<int> ha(N), hb(N);
+    portableCopyToHost(ha.data(), a, N * sizeof(int));
+    portableCopyToHost(hb.data(), b, N * sizeof(int));
+    int running = 0;
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(ha[i] == static_cast<int>((base + i) % 7));
+      REQUIRE(hb[i] == running);
+      running += ha[i];
+    }
+    REQUIRE(total == running);
+  }
+
+  SECTION("Other integer bounds take the 32-bit path when they fit") {
+    STATIC_REQUIRE(std::is_same_v<PortsOfCall::impl::loop_index_t<int, int>, int>);
+    STATIC_REQUIRE(
+        std::is_same_v<PortsOfCall::impl::loop_index_t<int, std::size_t>, std::int64_t>);
+    REQUIRE(PortsOfCall::impl::FitsInInt(std::size_t(0), std::int64_t(N)));
+    REQUIRE_FALSE(PortsOfCall::impl::FitsInInt(0, base));
+    portableFor(
+        "size_t fill", std::size_t(0), std::size_t(N),
+        PORTABLE_LAMBDA(const std::int64_t i) { a[i] = static_cast<int>(i); });
+    std::int64_t sum = 0;
+    portableReduce(
+        "mixed sum", 0, std::int64_t(N),
+        PORTABLE_LAMBDA(const std::int64_t i, std::int64_t &s) { s += a[i]; }, sum);
+    REQUIRE(sum == std::int64_t(N) * (N - 1) / 2);
+  }
+
+  SECTION("PortableMDArray extents and sizes are 64-bit") {
+    PortableMDArray<double> big(nullptr, 4, 1 << 20, 1 << 10);
+    REQUIRE(big.GetSize() == std::int64_t(1) << 32);
+    REQUIRE(big.GetSizeInBytes() == (std::size_t(1) << 32) * sizeof(double));
+    big.Reshape(1 << 12, 1 << 20);
+    REQUIRE(big.GetDim1() == 1 << 20);
+    REQUIRE(big.GetDim2() == 1 << 12);
+    REQUIRE(big.GetSize() == std::int64_t(1) << 32);
+  }
+
+  PORTABLE_FREE(a);
+  PORTABLE_FREE(b);
+}
+
+TEST_CASE("portableForSimd hands out masked packs of indices", "[portableForSimd]") {
+  using PortsOfCall::Simd;
+  using PortsOfCall::SimdIndex;
+  constexpr int N = 37;
+  Real *const x = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  Real *const y = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  portableFor(
+      "init", 0, N, PORTABLE_LAMBDA(const int i) {
+        x[i] = i + 1;
+        y[i] = -1;
+      });
+
+  SECTION("Every index is visited once and the remainder is masked") {
+    constexpr int W = 4;
+    portableForSimd<W>(
+        "simd axpy", 3, N, PORTABLE_LAMBDA(const SimdIndex<W> &i) {
+          const auto xs = PortsOfCall::SimdLoad(x, i);
+          const auto ys = sqrt(xs * xs) * 2 + Real(1);
+          PortsOfCall::SimdStore(y, i, Select(xs > Real(10), ys, -xs));
+        });
+    std::vector<Real> hy(N);
+    portableCopyToHost(hy.data(), y, N * sizeof(Real));
+    for (int i = 0; i < N; ++i) {
+      const Real xi = i + 1;
+      REQUIRE(hy[i] == (i < 3 ? -1 : (xi > 10 ? 2 * xi + 1 : -xi)));
+    }
+  }
+
+#ifndef PORTABILITY_STRATEGY_KOKKOS
+  SECTION("The default width and explicit execution spaces work") {
+    int packs = 0;
+    std::vector<int> seen(N, 0);
+    portableForSimd("simd host", PortsOfCall::Exec::Host(), 0, N,
+                    [&](const SimdIndex<> &i) {
+                      packs++;
+                      REQUIRE(i.Mask().Count() == i.Count());
+                      REQUIRE((i.Full() || i.First() + i.Count() == N));
+                      for (int l = 0; l < i.Count(); ++l) {
+                        seen[i[l]]++;
+                      }
+                    });
+    constexpr int W = SimdIndex<>::width;
+    REQUIRE(packs == (N + W - 1) / W);
+    REQUIRE(std::all_of(seen.begin(), seen.end(), [](int s) { return s == 1; }));
+  }
+#endif // PORTABILITY_STRATEGY_KOKKOS
+
+  SECTION("Simd values support masks, gathers and horizontal reductions") {
+    Simd<double, 4> a(0.0);
+    for (int l = 0; l < 4; ++l) {
+      a[l] = l - 1.5;
+    }
+    const auto positive = a > 0.0;
+    REQUIRE(positive.Count() == 2);
+    REQUIRE(positive.Any());
+    REQUIRE_FALSE(positive.All());
+    REQUIRE((!positive || positive).All());
+    REQUIRE(PortsOfCall::ReduceAdd(abs(a)) == 4.0);
+    REQUIRE(PortsOfCall::ReduceMin(a) == -1.5);
+    REQUIRE(PortsOfCall::ReduceMax(max(a, Simd<double, 4>(1.0))) == 1.5);
+    const double table[] = {10, 20, 30, 40};
+    Simd<int, 4> index(0);
+    index[0] = 3;
+    index[2] = 1;
+    const auto g = Simd<double, 4>::Gather(table, index, positive, -1.0);
+    REQUIRE(g[0] == -1.0);
+    REQUIRE(g[2] == 20.0);
+    REQUIRE(g[3] == 10.0);
+    const auto m = PortsOfCall::SimdMap([](double v, int k) { return v * k; }, a, 2);
+    REQUIRE(m[3] == 3.0);
+  }
+
+  PORTABLE_FREE(x);
+  PORTABLE_FREE(y);
+}
+
+TEST_CASE("portableFor with compile-time bounds", "[portableFor]") {
+  constexpr int NZ = 4, NC = 3, NX = 5;
+  constexpr int N = NZ * NC * NX;
+  int *const hits = static_cast<int *>(PORTABLE_MALLOC(N * sizeof(int)));
+  std::vector<int> h(N);
+  const auto check = [&](const int expected) {
+    portableCopyToHost(h.data(), hits, N * sizeof(int));
+    for (int n = 0; n < N; ++n) {
+      REQUIRE(h[n] == expected);
+    }
+  };
+  portableFor(
+      "zero", 0, N, PORTABLE_LAMBDA(const int n) { hits[n] = 0; });
+
+  SECTION("A static dimension between dynamic ones") {
+    portableFor(
+        "static middle", 0, NZ, PortsOfCall::StaticRange<0, NC>{}, 0, NX,
+        PORTABLE_LAMBDA(const int k, const auto c, const int i) {
+          static_assert(decltype(c)::value >= 0 && decltype(c)::value < NC);
+          hits[i + NX * (c + NC * k)] += 1;
+        });
+    PORTABLE_FENCE();
+    check(1);
+  }
+
+  SECTION("Leading integral_constant bounds on an explicit space") {
+    portableFor(
+        "static leading", PortsOfCall::Exec::HostParallel(),
+        std::integral_constant<int, 0>{}, std::integral_constant<int, NZ>{}, 0, NC,
+        PortsOfCall::StaticRange<0, NX>{},
+        PORTABLE_LAMBDA(const int k, const int c, const int i) {
+          hits[i + NX * (c + NC * k)] += 2;
+        });
+    PORTABLE_FENCE();
+    check(2);
+  }
+
+  SECTION("Only static dimensions") {
+    portableFor(
+        "static only", PortsOfCall::StaticRange<0, NZ>{},
+        PortsOfCall::StaticRange<0, NC>{}, PortsOfCall::StaticRange<0, NX>{},
+        PORTABLE_LAMBDA(const int k, const int c, const int i) {
+          hits[i + NX * (c + NC * k)] += 3;
+        });
+    PORTABLE_FENCE();
+    check(3);
+  }
+
+  PORTABLE_FREE(hits);
+}
+
+TEST_CASE("portableForFused runs every body in one traversal", "[portableForFused]") {
+  constexpr int NZ = 3, NY = 5, NX = 7;
+  constexpr int N = NZ * NY * NX;
+  Real *const rho = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  Real *const p = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  Real *const c = static_cast<Real *>(PORTABLE_MALLOC(N * sizeof(Real)));
+  PortableMDArray<Real> rho_a(rho, NZ, NY, NX), p_a(p, NZ, NY, NX), c_a(c, NZ, NY, NX);
+  std::vector<Real> hp(N), hc(N);
+  const auto check = [&]() {
+    portableCopyToHost(hp.data(), p, N * sizeof(Real));
+    portableCopyToHost(hc.data(), c, N * sizeof(Real));
+    for (int n = 0; n < N; ++n) {
+      REQUIRE(hp[n] == 2 * n);
+      REQUIRE(hc[n] == 2 * n + n);
+    }
+  };
+  // later bodies may read what earlier ones wrote at the same index
+  const auto init = PORTABLE_LAMBDA(const int k, const int j, const int i) {
+    rho_a(k, j, i) = i + NX * (j + NY * k);
+  };
+  const auto pressure = PORTABLE_LAMBDA(const int k, const int j, const int i) {
+    p_a(k, j, i) = 2 * rho_a(k, j, i);
+  };
+  const auto sound = PORTABLE_LAMBDA(const int k, const int j, const int i) {
+    c_a(k, j, i) = p_a(k, j, i) + rho_a(k, j, i);
+  };
+
+  SECTION("Three-dimensional bodies on the default space") {
+    portableForFused("fused 3D", 0, NZ, 0, NY, 0, NX, init, pressure, sound);
+    PORTABLE_FENCE();
+    check();
+  }
+
+  SECTION("Tiled traversal on an explicit space") {
+    portableForFused("fused tiled", PortsOfCall::Exec::HostParallel(),
+                     PortsOfCall::TileSizes{2, 2, 4}, 0, NZ, 0, NY, 0, NX, init, pressure,
+                     sound);
+    PORTABLE_FENCE();
+    check();
+  }
+
+  SECTION("One-dimensional bodies with 64-bit bounds") {
+    portableForFused(
+        "fused 1D", PortsOfCall::Exec::Device(), std::int64_t(0), std::int64_t(N),
+        PORTABLE_LAMBDA(const std::int64_t n) { rho[n] = n; },
+        PORTABLE_LAMBDA(const std::int64_t n) { p[n] = 2 * rho[n]; },
+        PORTABLE_LAMBDA(const std::int64_t n) { c[n] = p[n] + rho[n]; });
+    PORTABLE_FENCE();
+    check();
+  }
+
+  PORTABLE_FREE(rho);
+  PORTABLE_FREE(p);
+  PORTABLE_FREE(c);
+}
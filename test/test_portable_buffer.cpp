@@ -0,0 +1,159 @@
+#include "ports-of-call/portability.hpp"
+#include "ports-of-call/portable_buffer.hpp"
+
+#ifndef CATCH_CONFIG_FAST_COMPILE
+#define CATCH_CONFIG_FAST_COMPILE
+#include <catch2/catch_test_macros.hpp>
+#endif
+
+#include <type_traits>
+#include <utility>
+
+using PortsOfCall::Exec::Device;
+using PortsOfCall::Exec::Host;
+
+static_assert(!std::is_copy_constructible_v<PortableBuffer<double>>);
+static_assert(!std::is_copy_assignable_v<PortableBuffer<double>>);
+static_assert(std::is_nothrow_move_constructible_v<PortableBuffer<double>>);
+
+TEST_CASE("PortableBuffer owns and moves its memory", "[PortableBuffer]") {
+  constexpr int N = 24;
+  PortableBuffer<double> buffer(N);
+  REQUIRE(buffer.size() == N);
+  REQUIRE(buffer.bytes() == N * sizeof(double));
+  REQUIRE(buffer.use_count() == 1);
+  REQUIRE(buffer.data() != nullptr);
+
+  SECTION("views fill the buffer in any shape") {
+    auto v = buffer.view(2, 3, 4);
+    REQUIRE(v.GetDim3() == 2);
+    REQUIRE(v.GetDim1() == 4);
+    portableFor(
+        "fill", 0, 2, 0, 3, 0, 4,
+        PORTABLE_LAMBDA(int k, int j, int i) { v(k, j, i) = 12 * k + 4 * j + i; });
+    auto flat = buffer.view();
+    int wrong = 0;
+    portableReduce(
+        "check", 0, N,
+        PORTABLE_LAMBDA(int i, int &w) { w += flat(i) != i; }, wrong);
+    REQUIRE(wrong == 0);
+  }
+
+  SECTION("moving transfers ownership") {
+    double *const data = buffer.data();
+    PortableBuffer<double> moved(std::move(buffer));
+    REQUIRE(moved.data() == data);
+    REQUIRE(moved.size() == N);
+    REQUIRE(buffer.empty());
+    REQUIRE(buffer.data() == nullptr);
+    REQUIRE(buffer.use_count() == 0);
+
+    PortableBuffer<double> assigned(4);
+    assigned = std::move(moved);
+    REQUIRE(assigned.data() == data);
+    REQUIRE(moved.empty());
+  }
+
+  SECTION("release hands the memory to the caller") {
+    double *const data = buffer.release();
+    REQUIRE(buffer.empty());
+    REQUIRE(buffer.use_count() == 0);
+    PortsOfCall::portableFree(Device(), data);
+  }
+
+  SECTION("reset frees the memory") {
+    buffer.reset();
+    REQUIRE(buffer.empty());
+    REQUIRE(buffer.data() == nullptr);
+  }
+}
+
+TEST_CASE("PortableBuffer mirrors between spaces", "[PortableBuffer]") {
+  constexpr int N = 32;
+  PortableBuffer<int> device(N);
+  auto d = device.view();
+  portableFor("fill", 0, N, PORTABLE_LAMBDA(int i) { d(i) = 3 * i; });
+  constexpr bool alias = PortsOfCall::impl::spaces_alias_v<Device, Host>;
+
+  SECTION("a mirror of a kept buffer copies unless the spaces alias") {
+    auto host = device.mirror<Host>();
+    REQUIRE(host.size() == N);
+    REQUIRE((host.data() == device.data()) == alias);
+    REQUIRE(device.use_count() == (alias ? 2 : 1));
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(host.data()[i] == 3 * i);
+    }
+    auto same = device.mirror<Device>();
+    REQUIRE(same.data() == device.data());
+    REQUIRE(same.use_count() == (alias ? 3 : 2));
+  }
+
+  SECTION("a mirror stays valid after its source is gone") {
+    auto host = device.mirror<Host>();
+    device.reset();
+    REQUIRE(host.use_count() == 1);
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(host.data()[i] == 3 * i);
+    }
+  }
+
+  SECTION("a mirror of an rvalue takes the memory when the spaces alias") {
+    int *const data = device.data();
+    auto host = std::move(device).mirror<Host>();
+    REQUIRE(host.use_count() == 1);
+    REQUIRE((host.data() == data) == alias);
+    REQUIRE(device.empty() == alias);
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(host.data()[i] == 3 * i);
+    }
+  }
+
+  SECTION("clone always copies") {
+    auto copy = device.clone<Host>();
+    REQUIRE(copy.use_count() == 1);
+    REQUIRE(copy.data() != device.data());
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(copy.data()[i] == 3 * i);
+    }
+  }
+}
+
+TEST_CASE("PortableDualBuffer transfers only when the other side changed",
+          "[PortableBuffer]") {
+  constexpr int N = 16;
+  constexpr bool aliased = PortableDualBuffer<int>::aliased;
+  const std::size_t bytes = N * sizeof(int);
+  PortsOfCall::ResetDualSyncTotals();
+  PortableDualBuffer<int> dual(N);
+  REQUIRE(dual.size() == N);
+  REQUIRE((dual.data<Host>() == dual.data<Device>()) == aliased);
+
+  auto h = dual.view<Host>();
+  for (int i = 0; i < N; ++i) {
+    h(i) = i;
+  }
+  dual.modify<Host>();
+  REQUIRE(dual.need_sync<Device>() == !aliased);
+  REQUIRE(!dual.need_sync<Host>());
+  dual.sync<Device>();
+  dual.sync<Device>();
+  REQUIRE(!dual.need_sync<Device>());
+  REQUIRE(dual.stats().syncs == 2);
+  REQUIRE(dual.stats().bytes_moved == (aliased ? 0 : bytes));
+  REQUIRE(dual.stats().bytes_elided == (aliased ? 2 : 1) * bytes);
+
+  auto d = dual.view<Device>();
+  portableFor("double", 0, N, PORTABLE_LAMBDA(int i) { d(i) *= 2; });
+  dual.modify<Device>();
+  dual.sync<Host>();
+  for (int i = 0; i < N; ++i) {
+    REQUIRE(h(i) == 2 * i);
+  }
+  // a host-side sync when the host is current is elided
+  dual.sync<PortsOfCall::Exec::HostParallel>();
+
+  const auto totals = PortsOfCall::DualSyncTotals();
+  REQUIRE(totals.syncs == 4);
+  REQUIRE(totals.bytes_moved == (aliased ? 0 : 2 * bytes));
+  REQUIRE(totals.bytes_moved + totals.bytes_elided == 4 * bytes);
+}
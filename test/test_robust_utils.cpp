@@ -70,6 +70,11 @@ TEST_CASE("robust_utils numeric helpers", "[robust_utils]") {
   CHECK_THAT(Robust::ratio(6.0, 3.0), WithinRel(2.0));
   CHECK(Robust::ratio(0.0, 0.0) == 0.0);
   CHECK(Robust::ratio(1.0, 0.0) > 1.0e300);
+  PortsOfCall::Simd<double, 2> denom(3.0);
+  denom[1] = 0.0;
+  const auto r = Robust::ratio(6.0, denom);
+  CHECK_THAT(r[0], WithinRel(2.0));
+  CHECK(r[1] > 1.0e300);
 
   CHECK(Robust::safe_arg_exp(Robust::min_exp_arg<double>() - 1.0) == 0.0);
   CHECK(Robust::safe_arg_exp(Robust::max_exp_arg<double>() + 1.0) ==